@@ -2,11 +2,15 @@
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
+#include "Instrumentation.h"
 
 using namespace std;
 
 BankersAlgorithm::BankersAlgorithm(int numResourceTypes, const vector<int>& totalResources) 
-    : numResources(numResourceTypes), maxResources(totalResources), available(totalResources) {
+    : numResources(numResourceTypes), available(totalResources), maxResources(totalResources),
+      allocatedTotal(numResourceTypes, 0), cannotFinishCount(0),
+      safeOrderValid(true), safeSequenceComputed(false), kernel(&resourceKernelFor(numResourceTypes)),
+      lockedAt(0) {
     pthread_mutex_init(&resourceMutex, NULL);
 }
 
@@ -14,10 +18,75 @@ BankersAlgorithm::~BankersAlgorithm() {
     pthread_mutex_destroy(&resourceMutex);
 }
 
-void BankersAlgorithm::addProcess(Process* process) {
+void BankersAlgorithm::lockResources() {
     pthread_mutex_lock(&resourceMutex);
-    processes.push_back(process);
+    INSTRUMENT_MARK(lockedAt);
+}
+
+void BankersAlgorithm::unlockResources() {
+    INSTRUMENT_RECORD(METRIC_RESOURCE_LOCK_HOLD, lockedAt);
+    pthread_mutex_unlock(&resourceMutex);
+}
+
+void BankersAlgorithm::invalidateSafeOrder() {
+    if (safeOrderValid && safeSequenceComputed) {
+        // Keep the last sequence around for display
+        safeSequence.clear();
+        for (int slot : safeOrder) {
+            safeSequence.push_back(processes[slot]->processID);
+        }
+    }
+    safeOrder.clear();
+    safeOrderValid = false;
+}
+
+void BankersAlgorithm::updateCannotFinish(int slot) {
+    // Work peaks at available + allocatedTotal once everyone has released,
+    // so a need above that can never be met in any order
+    const int* need = needRow(slot);
+    bool exceeds = false;
+    for (int i = 0; i < numResources; i++) {
+        if (need[i] > available[i] + allocatedTotal[i]) {
+            exceeds = true;
+            break;
+        }
+    }
+    if (exceeds != cannotFinish[slot]) {
+        cannotFinish[slot] = exceeds;
+        cannotFinishCount += exceeds ? 1 : -1;
+    }
+}
+
+void BankersAlgorithm::syncProcess(int slot) {
+    const int* allocation = allocationRow(slot);
+    processes[slot]->allocatedResources.assign(allocation, allocation + numResources);
+}
+
+void BankersAlgorithm::addProcess(Process* process) {
+    lockResources();
+    addProcessLocked(process);
+    unlockResources();
+}
+
+void BankersAlgorithm::addProcesses(Process* const* list, int count) {
+    lockResources();
+    
+    size_t total = processes.size() + count;
+    processes.reserve(total);
+    slotOf.reserve(total);
+    maxMatrix.reserve(total * numResources);
+    allocationMatrix.reserve(total * numResources);
+    needMatrix.reserve(total * numResources);
+    orderPosition.reserve(total);
+    
+    for (int i = 0; i < count; i++) {
+        addProcessLocked(list[i]);
+    }
     
+    unlockResources();
+}
+
+void BankersAlgorithm::addProcessLocked(Process* process) {
     // Initialize allocated resources to 0
     process->allocatedResources.resize(numResources, 0);
     
@@ -26,15 +95,87 @@ void BankersAlgorithm::addProcess(Process* process) {
         process->resourceRequirements.resize(numResources, 0);
     }
     
-    pthread_mutex_unlock(&resourceMutex);
+    int slot = processes.size();
+    processes.push_back(process);
+    slotOf[process] = slot;
+    maxMatrix.resize(maxMatrix.size() + numResources);
+    allocationMatrix.resize(allocationMatrix.size() + numResources);
+    needMatrix.resize(needMatrix.size() + numResources);
+    cannotFinish.push_back(false);
+    
+    int* max = maxRow(slot);
+    int* allocation = allocationRow(slot);
+    int* need = needRow(slot);
+    bool holdsResources = false;
+    for (int i = 0; i < numResources; i++) {
+        max[i] = process->resourceRequirements[i];
+        allocation[i] = process->allocatedResources[i];
+        need[i] = max[i] - allocation[i];
+        allocatedTotal[i] += allocation[i];
+        holdsResources = holdsResources || allocation[i] != 0;
+    }
+    if (holdsResources) {
+        for (size_t i = 0; i < processes.size(); i++) {
+            updateCannotFinish(i);
+        }
+    } else {
+        updateCannotFinish(slot);
+    }
+    
+    // The new process can only extend the sequence at the tail, where work is
+    // largest; if it does not fit there it fits nowhere and the state is unsafe.
+    // That only holds if it arrives empty-handed: an allocation shrinks the
+    // work at every position of the cached order, and cannotFinish was
+    // computed with that allocation already counted in.
+    orderPosition.push_back(safeOrder.end());
+    if (safeOrderValid && !holdsResources && !cannotFinish[slot]) {
+        orderPosition[slot] = safeOrder.insert(safeOrder.end(), slot);
+    } else {
+        invalidateSafeOrder();
+    }
 }
 
 void BankersAlgorithm::removeProcess(Process* process) {
-    pthread_mutex_lock(&resourceMutex);
+    lockResources();
     
-    auto it = find(processes.begin(), processes.end(), process);
-    if (it != processes.end()) {
-        processes.erase(it);
+    auto it = slotOf.find(process);
+    if (it != slotOf.end()) {
+        int slot = it->second;
+        int last = processes.size() - 1;
+        invalidateSafeOrder();
+        
+        bool holdsResources = false;
+        const int* allocation = allocationRow(slot);
+        for (int i = 0; i < numResources; i++) {
+            allocatedTotal[i] -= allocation[i];
+            holdsResources = holdsResources || allocation[i] != 0;
+        }
+        if (cannotFinish[slot]) {
+            cannotFinishCount--;
+        }
+        
+        // Move the last slot into the hole to keep slots dense
+        if (slot != last) {
+            processes[slot] = processes[last];
+            slotOf[processes[slot]] = slot;
+            copy(maxRow(last), maxRow(last) + numResources, maxRow(slot));
+            copy(allocationRow(last), allocationRow(last) + numResources, allocationRow(slot));
+            copy(needRow(last), needRow(last) + numResources, needRow(slot));
+            cannotFinish[slot] = cannotFinish[last];
+        }
+        processes.pop_back();
+        slotOf.erase(it);
+        maxMatrix.resize(last * numResources);
+        allocationMatrix.resize(last * numResources);
+        needMatrix.resize(last * numResources);
+        cannotFinish.pop_back();
+        orderPosition.pop_back();
+        
+        if (holdsResources) {
+            for (size_t i = 0; i < processes.size(); i++) {
+                updateCannotFinish(i);
+            }
+        }
     }
     
     // Remove from blocked list if present
@@ -43,76 +184,69 @@ void BankersAlgorithm::removeProcess(Process* process) {
         blockedProcesses.erase(bit);
     }
     
-    pthread_mutex_unlock(&resourceMutex);
+    unlockResources();
 }
 
-bool BankersAlgorithm::canAllocate(const Process& p, const vector<int>& tempAvailable) {
-    for (int i = 0; i < numResources; i++) {
-        int need = p.resourceRequirements[i] - p.allocatedResources[i];
-        if (need > tempAvailable[i]) {
-            return false;
-        }
-    }
-    return true;
+bool BankersAlgorithm::canAllocate(int slot, const vector<int>& tempAvailable) {
+    return kernel->fits(needRow(slot), tempAvailable.data(), numResources);
 }
 
 bool BankersAlgorithm::isSafe(const vector<int>& tempAvailable) {
-    vector<bool> finished(processes.size(), false);
+    INSTRUMENT_START(checkStart);
+    int numSlots = processes.size();
+    vector<bool> finished(numSlots, false);
     vector<int> work = tempAvailable;
     vector<int> sequence;
     
     int count = 0;
-    while (count < processes.size()) {
+    while (count < numSlots) {
         bool found = false;
         
-        for (int i = 0; i < processes.size(); i++) {
-            if (!finished[i]) {
-                bool canProceed = true;
+        for (int i = 0; i < numSlots; i++) {
+            // Check if process can finish with available resources
+            if (!finished[i] && canAllocate(i, work)) {
+                // Process can finish, release its resources
+                kernel->add(work.data(), allocationRow(i), numResources);
                 
-                // Check if process can finish with available resources
-                for (int j = 0; j < numResources; j++) {
-                    int need = processes[i]->resourceRequirements[j] - 
-                               processes[i]->allocatedResources[j];
-                    if (need > work[j]) {
-                        canProceed = false;
-                        break;
-                    }
-                }
-                
-                if (canProceed) {
-                    // Process can finish, release its resources
-                    for (int j = 0; j < numResources; j++) {
-                        work[j] += processes[i]->allocatedResources[j];
-                    }
-                    
-                    sequence.push_back(processes[i]->processID);
-                    finished[i] = true;
-                    found = true;
-                    count++;
-                }
+                sequence.push_back(i);
+                finished[i] = true;
+                found = true;
+                count++;
             }
         }
         
         if (!found) {
             // No process can proceed - unsafe state
+            INSTRUMENT_RECORD(METRIC_SAFETY_CHECK, checkStart);
             return false;
         }
     }
     
-    // System is safe, update safe sequence
-    safeSequence = sequence;
+    // System is safe, cache the sequence for incremental checks
+    safeOrder.assign(sequence.begin(), sequence.end());
+    for (auto it = safeOrder.begin(); it != safeOrder.end(); ++it) {
+        orderPosition[*it] = it;
+    }
+    safeOrderValid = true;
+    safeSequenceComputed = true;
+    INSTRUMENT_RECORD(METRIC_SAFETY_CHECK, checkStart);
     return true;
 }
 
 bool BankersAlgorithm::requestResources(Process* process) {
-    pthread_mutex_lock(&resourceMutex);
+    lockResources();
+    INSTRUMENT_COUNT(COUNTER_BANKER_REQUESTS, 1);
+    
+    auto found = slotOf.find(process);
+    int slot = (found != slotOf.end()) ? found->second : -1;
     
     // Create temporary available vector for testing
     vector<int> tempAvailable = available;
     
     // Simulate allocation
     for (int i = 0; i < numResources; i++) {
-        int request = process->resourceRequirements[i] - process->allocatedResources[i];
+        int request = (slot >= 0) ? needRow(slot)[i]
+                    : process->resourceRequirements[i] - process->allocatedResources[i];
         
         // Check if request exceeds available
         if (request > tempAvailable[i]) {
@@ -121,21 +255,64 @@ bool BankersAlgorithm::requestResources(Process* process) {
                      process->processID) == blockedProcesses.end()) {
                 blockedProcesses.push_back(process->processID);
             }
-            pthread_mutex_unlock(&resourceMutex);
+            INSTRUMENT_COUNT(COUNTER_BANKER_DENIED, 1);
+            unlockResources();
             return false;
         }
         
         tempAvailable[i] -= request;
     }
     
-    // Temporarily allocate resources to test safety
-    vector<int> oldAllocated = process->allocatedResources;
-    process->allocatedResources = process->resourceRequirements;
+    bool safe;
+    if (cannotFinishCount > 0) {
+        // Some other process can never finish, whatever is granted here
+        safe = false;
+    } else if (slot >= 0 && safeOrderValid) {
+        // The granted process will need nothing, so it can finish first and
+        // hand back more than it took; every later entry of the cached
+        // sequence then sees at least the work it saw before.
+        safeOrder.splice(safeOrder.begin(), safeOrder, orderPosition[slot]);
+        safeSequenceComputed = true;
+        safe = true;
+        INSTRUMENT_COUNT(COUNTER_SAFE_ORDER_HITS, 1);
+    } else if (slot >= 0) {
+        // Temporarily allocate resources to test safety
+        vector<int> oldAllocation(allocationRow(slot), allocationRow(slot) + numResources);
+        vector<int> oldNeed(needRow(slot), needRow(slot) + numResources);
+        copy(maxRow(slot), maxRow(slot) + numResources, allocationRow(slot));
+        fill(needRow(slot), needRow(slot) + numResources, 0);
+        safe = isSafe(tempAvailable);
+        
+        // The commit below re-applies the allocation; rollback the need if unsafe
+        copy(oldAllocation.begin(), oldAllocation.end(), allocationRow(slot));
+        if (!safe) {
+            copy(oldNeed.begin(), oldNeed.end(), needRow(slot));
+        }
+    } else {
+        // Resources held by an unregistered process never return to work
+        safe = isSafe(tempAvailable);
+    }
     
     // Check if system remains safe
-    if (isSafe(tempAvailable)) {
+    if (safe) {
         // Safe - commit the allocation
         available = tempAvailable;
+        if (slot >= 0) {
+            int* allocation = allocationRow(slot);
+            const int* max = maxRow(slot);
+            for (int i = 0; i < numResources; i++) {
+                allocatedTotal[i] += max[i] - allocation[i];
+                allocation[i] = max[i];
+            }
+            fill(needRow(slot), needRow(slot) + numResources, 0);
+            updateCannotFinish(slot);
+            syncProcess(slot);
+        } else {
+            process->allocatedResources = process->resourceRequirements;
+            for (size_t i = 0; i < processes.size(); i++) {
+                updateCannotFinish(i);
+            }
+        }
         process->isBlocked = false;
         
         // Remove from blocked list
@@ -144,11 +321,10 @@ bool BankersAlgorithm::requestResources(Process* process) {
             blockedProcesses.erase(it);
         }
         
-        pthread_mutex_unlock(&resourceMutex);
+        unlockResources();
         return true;
     } else {
-        // Unsafe - rollback and block process
-        process->allocatedResources = oldAllocated;
+        // Unsafe - block process
         process->isBlocked = true;
         
         if (find(blockedProcesses.begin(), blockedProcesses.end(), 
@@ -156,25 +332,46 @@ bool BankersAlgorithm::requestResources(Process* process) {
             blockedProcesses.push_back(process->processID);
         }
         
-        pthread_mutex_unlock(&resourceMutex);
+        INSTRUMENT_COUNT(COUNTER_BANKER_DENIED, 1);
+        unlockResources();
         return false;
     }
 }
 
 void BankersAlgorithm::releaseResources(Process* process) {
-    pthread_mutex_lock(&resourceMutex);
+    lockResources();
     
-    // Release all allocated resources
-    for (int i = 0; i < numResources; i++) {
-        available[i] += process->allocatedResources[i];
-        process->allocatedResources[i] = 0;
+    auto found = slotOf.find(process);
+    
+    if (found != slotOf.end()) {
+        // Release all allocated resources. A cached safe sequence stays valid:
+        // the work before this process grows by exactly what its need grows by.
+        int slot = found->second;
+        int* allocation = allocationRow(slot);
+        int* need = needRow(slot);
+        for (int i = 0; i < numResources; i++) {
+            available[i] += allocation[i];
+            need[i] += allocation[i];
+            allocatedTotal[i] -= allocation[i];
+            allocation[i] = 0;
+        }
+        updateCannotFinish(slot);
+        syncProcess(slot);
+    } else {
+        for (int i = 0; i < numResources; i++) {
+            available[i] += process->allocatedResources[i];
+            process->allocatedResources[i] = 0;
+        }
+        for (size_t i = 0; i < processes.size(); i++) {
+            updateCannotFinish(i);
+        }
     }
     
-    pthread_mutex_unlock(&resourceMutex);
+    unlockResources();
 }
 
 void BankersAlgorithm::displaySystemState() {
-    pthread_mutex_lock(&resourceMutex);
+    lockResources();
     
     cout << "\n========================================" << endl;
     cout << "     RESOURCE MANAGEMENT STATE" << endl;
@@ -198,13 +395,17 @@ void BankersAlgorithm::displaySystemState() {
              << setw(10) << "Status" << endl;
         cout << string(78, '-') << endl;
         
-        for (const auto& p : processes) {
+        for (size_t slot = 0; slot < processes.size(); slot++) {
+            const Process* p = processes[slot];
+            const int* max = maxRow(slot);
+            const int* allocation = allocationRow(slot);
+            const int* need = needRow(slot);
             cout << left << setw(8) << p->processID;
             
             // Max
             cout << "[";
             for (int i = 0; i < numResources; i++) {
-                cout << p->resourceRequirements[i];
+                cout << max[i];
                 if (i < numResources - 1) cout << ",";
             }
             cout << "]" << setw(20 - numResources * 2) << " ";
@@ -212,7 +413,7 @@ void BankersAlgorithm::displaySystemState() {
             // Allocated
             cout << "[";
             for (int i = 0; i < numResources; i++) {
-                cout << p->allocatedResources[i];
+                cout << allocation[i];
                 if (i < numResources - 1) cout << ",";
             }
             cout << "]" << setw(20 - numResources * 2) << " ";
@@ -220,7 +421,7 @@ void BankersAlgorithm::displaySystemState() {
             // Need
             cout << "[";
             for (int i = 0; i < numResources; i++) {
-                cout << (p->resourceRequirements[i] - p->allocatedResources[i]);
+                cout << need[i];
                 if (i < numResources - 1) cout << ",";
             }
             cout << "]" << setw(20 - numResources * 2) << " ";
@@ -232,6 +433,7 @@ void BankersAlgorithm::displaySystemState() {
     }
     
     // Display safe sequence
+    vector<int> safeSequence = getSafeSequence();
     if (!safeSequence.empty()) {
         cout << "Safe Sequence: <";
         for (int i = 0; i < safeSequence.size(); i++) {
@@ -257,11 +459,41 @@ void BankersAlgorithm::displaySystemState() {
     
     cout << "========================================\n" << endl;
     
-    pthread_mutex_unlock(&resourceMutex);
+    unlockResources();
+}
+
+BankerSnapshot BankersAlgorithm::snapshot() {
+    lockResources();
+    
+    BankerSnapshot state;
+    state.total = maxResources;
+    state.available = available;
+    state.processIDs.reserve(processes.size());
+    state.blocked.reserve(processes.size());
+    for (const Process* p : processes) {
+        state.processIDs.push_back(p->processID);
+        state.blocked.push_back(p->isBlocked);
+    }
+    state.maxMatrix = maxMatrix;
+    state.allocationMatrix = allocationMatrix;
+    state.needMatrix = needMatrix;
+    state.safeSequence = getSafeSequence();
+    state.blockedProcesses = blockedProcesses;
+    
+    unlockResources();
+    return state;
 }
 
 vector<int> BankersAlgorithm::getSafeSequence() const {
-    return safeSequence;
+    if (!safeOrderValid || !safeSequenceComputed) {
+        return safeSequence;
+    }
+    vector<int> sequence;
+    sequence.reserve(safeOrder.size());
+    for (int idx : safeOrder) {
+        sequence.push_back(processes[idx]->processID);
+    }
+    return sequence;
 }
 
 vector<int> BankersAlgorithm::getBlockedProcesses() const {
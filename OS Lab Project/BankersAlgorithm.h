@@ -2,23 +2,71 @@
 #define BANKERS_ALGORITHM_H
 
 #include <vector>
+#include <list>
+#include <unordered_map>
 #include <pthread.h>
+#include <stdint.h>
 #include "Process.h"
+#include "ResourceKernel.h"
+
+// Copy of the Banker's state for export; matrices are row-major with one
+// row of resource counts per process, in processIDs order
+struct BankerSnapshot {
+    std::vector<int> total;
+    std::vector<int> available;
+    std::vector<int> processIDs;
+    std::vector<bool> blocked;
+    std::vector<int> maxMatrix;
+    std::vector<int> allocationMatrix;
+    std::vector<int> needMatrix;
+    std::vector<int> safeSequence;      // Empty until a request was checked
+    std::vector<int> blockedProcesses;
+};
 
 class BankersAlgorithm {
 private:
     int numResources;
     std::vector<int> available;      // Available resources
     std::vector<int> maxResources;   // Total resources in system
-    std::vector<Process*> processes; // All processes
+    std::vector<Process*> processes; // All processes, indexed by slot
     std::vector<int> safeSequence;   // Last computed safe sequence
     std::vector<int> blockedProcesses; // Blocked process IDs
     
+    // Row-major matrices, one row of numResources per process slot
+    std::vector<int> maxMatrix;        // Max demand
+    std::vector<int> allocationMatrix; // Currently allocated
+    std::vector<int> needMatrix;       // Max - Allocation
+    std::vector<int> allocatedTotal;   // Column sums of the Allocation matrix
+    std::unordered_map<Process*, int> slotOf; // Process -> dense slot
+    
+    // Incremental safety state
+    std::list<int> safeOrder;                   // Cached safe sequence (slots)
+    std::vector<std::list<int>::iterator> orderPosition; // Slot -> node in safeOrder
+    std::vector<bool> cannotFinish;             // Need exceeds total work in some column
+    int cannotFinishCount;
+    bool safeOrderValid;       // safeOrder proves the current state is safe
+    bool safeSequenceComputed; // A request has been checked at least once
+    
+    const ResourceKernel* kernel; // Vectorized row compare/add for safety checks
+    
     pthread_mutex_t resourceMutex;
+    uint64_t lockedAt;  // When resourceMutex was last acquired (instrumented builds)
+    
+    int* maxRow(int slot) { return &maxMatrix[slot * numResources]; }
+    int* allocationRow(int slot) { return &allocationMatrix[slot * numResources]; }
+    int* needRow(int slot) { return &needMatrix[slot * numResources]; }
+    
+    // resourceMutex, timing how long it is held
+    void lockResources();
+    void unlockResources();
     
     // Helper functions
     bool isSafe(const std::vector<int>& tempAvailable);
-    bool canAllocate(const Process& p, const std::vector<int>& tempAvailable);
+    bool canAllocate(int slot, const std::vector<int>& tempAvailable);
+    void invalidateSafeOrder();
+    void updateCannotFinish(int slot);
+    void syncProcess(int slot);
+    void addProcessLocked(Process* process);
     
 public:
     BankersAlgorithm(int numResourceTypes, const std::vector<int>& totalResources);
@@ -33,6 +81,9 @@ public:
     // Display system state
     void displaySystemState();
     
+    // Consistent copy of the state shown by displaySystemState
+    BankerSnapshot snapshot();
+    
     // Get safe sequence
     std::vector<int> getSafeSequence() const;
     
@@ -42,6 +93,9 @@ public:
     // Add process to system
     void addProcess(Process* process);
     
+    // Add count processes under a single lock acquisition
+    void addProcesses(Process* const* list, int count);
+    
     // Remove process from system
     void removeProcess(Process* process);
 };
@@ -1,56 +1,135 @@
 #include "BoundedBuffer.h"
-#include <iostream>
+#include "Logger.h"
+#include "Instrumentation.h"
 
-BoundedBuffer::BoundedBuffer(int size) : capacity(size) {
-    sem_init(&empty, 0, size);
+// A size below 1 gets one slot, like LockFreeBuffer
+BoundedBuffer::BoundedBuffer(int size) 
+    : buffer(size > 0 ? size : 1, nullptr), capacity(buffer.size()), head(0), count(0) {
+    sem_init(&empty, 0, capacity);
     sem_init(&full, 0, 0);
     pthread_mutex_init(&mutex, NULL);
 }
 
 BoundedBuffer::~BoundedBuffer() {
+    // Free anything nobody consumed
+    for (int i = 0; i < count; i++) {
+        delete buffer[(head + i) % capacity];
+    }
     sem_destroy(&empty);
     sem_destroy(&full);
     pthread_mutex_destroy(&mutex);
 }
 
-void BoundedBuffer::insert(const Process& process) {
+void BoundedBuffer::insert(Process* process) {
+    INSTRUMENT_START(waitStart);
     sem_wait(&empty);
+    INSTRUMENT_RECORD(METRIC_BUFFER_WAIT_SLOT, waitStart);
+    INSTRUMENT_COUNT(COUNTER_BUFFER_INSERTS, 1);
     
     pthread_mutex_lock(&mutex);
-    buffer.push(process);
-    std::cout << "[PRODUCER] Inserted Process P" << process.processID 
-              << " (Priority: " << process.priority 
-              << ", Burst: " << process.burstTime << ")" << std::endl;
+    buffer[(head + count) % capacity] = process;
+    count++;
     pthread_mutex_unlock(&mutex);
     
     sem_post(&full);
+    
+    LOG_DEBUG("[PRODUCER] Inserted Process P{} (Priority: {}, Burst: {})",
+              process->processID, process->priority, process->burstTime);
 }
 
-Process BoundedBuffer::remove() {
+Process* BoundedBuffer::remove() {
+    INSTRUMENT_START(waitStart);
     sem_wait(&full);
+    INSTRUMENT_RECORD(METRIC_BUFFER_WAIT_PROCESS, waitStart);
+    INSTRUMENT_COUNT(COUNTER_BUFFER_REMOVES, 1);
     
     pthread_mutex_lock(&mutex);
-    Process process = buffer.front();
-    buffer.pop();
-    std::cout << "[CONSUMER] Removed Process P" << process.processID 
-              << " from buffer" << std::endl;
+    Process* process = buffer[head];
+    head = (head + 1) % capacity;
+    count--;
     pthread_mutex_unlock(&mutex);
     
     sem_post(&empty);
     
+    LOG_DEBUG("[CONSUMER] Removed Process P{} from buffer", process->processID);
+    
     return process;
 }
 
+int BoundedBuffer::insertBatch(Process** processes, int numProcesses) {
+    if (numProcesses > maxBatchSize) numProcesses = maxBatchSize;
+    if (numProcesses <= 0) return 0;
+    
+    // Wait for one slot, then take whatever else is free without blocking
+    INSTRUMENT_START(waitStart);
+    sem_wait(&empty);
+    INSTRUMENT_RECORD(METRIC_BUFFER_WAIT_SLOT, waitStart);
+    int taken = 1;
+    while (taken < numProcesses && sem_trywait(&empty) == 0) {
+        taken++;
+    }
+    INSTRUMENT_COUNT(COUNTER_BUFFER_INSERTS, taken);
+    
+    pthread_mutex_lock(&mutex);
+    for (int i = 0; i < taken; i++) {
+        buffer[(head + count) % capacity] = processes[i];
+        count++;
+    }
+    pthread_mutex_unlock(&mutex);
+    
+    for (int i = 0; i < taken; i++) {
+        sem_post(&full);
+    }
+    
+    for (int i = 0; i < taken; i++) {
+        LOG_DEBUG("[PRODUCER] Inserted Process P{} (Priority: {}, Burst: {})",
+                  processes[i]->processID, processes[i]->priority, processes[i]->burstTime);
+    }
+    return taken;
+}
+
+int BoundedBuffer::removeBatch(Process** processes, int maxCount) {
+    if (maxCount > maxBatchSize) maxCount = maxBatchSize;
+    if (maxCount <= 0) return 0;
+    
+    // Wait for one process, then take whatever else is ready without blocking
+    INSTRUMENT_START(waitStart);
+    sem_wait(&full);
+    INSTRUMENT_RECORD(METRIC_BUFFER_WAIT_PROCESS, waitStart);
+    int taken = 1;
+    while (taken < maxCount && sem_trywait(&full) == 0) {
+        taken++;
+    }
+    INSTRUMENT_COUNT(COUNTER_BUFFER_REMOVES, taken);
+    
+    pthread_mutex_lock(&mutex);
+    for (int i = 0; i < taken; i++) {
+        processes[i] = buffer[head];
+        head = (head + 1) % capacity;
+        count--;
+    }
+    pthread_mutex_unlock(&mutex);
+    
+    for (int i = 0; i < taken; i++) {
+        sem_post(&empty);
+    }
+    
+    for (int i = 0; i < taken; i++) {
+        LOG_DEBUG("[CONSUMER] Removed Process P{} from buffer", processes[i]->processID);
+    }
+    return taken;
+}
+
 bool BoundedBuffer::isEmpty() {
     pthread_mutex_lock(&mutex);
-    bool empty = buffer.empty();
+    bool empty = (count == 0);
     pthread_mutex_unlock(&mutex);
     return empty;
 }
 
 int BoundedBuffer::size() {
     pthread_mutex_lock(&mutex);
-    int sz = buffer.size();
+    int sz = count;
     pthread_mutex_unlock(&mutex);
     return sz;
 }
@@ -1,15 +1,17 @@
 #ifndef BOUNDED_BUFFER_H
 #define BOUNDED_BUFFER_H
 
-#include <queue>
+#include <vector>
 #include <semaphore.h>
 #include <pthread.h>
-#include "Process.h"
+#include "ProcessBuffer.h"
 
-class BoundedBuffer {
+class BoundedBuffer : public ProcessBuffer {
 private:
-    std::queue<Process> buffer;
+    std::vector<Process*> buffer;  // Ring of owned processes
     int capacity;
+    int head;   // Oldest entry
+    int count;  // Entries in use
     
     // Semaphores for synchronization
     sem_t empty;  // Counts empty slots
@@ -23,10 +25,14 @@ public:
     ~BoundedBuffer();
     
     // Producer operation
-    void insert(const Process& process);
+    void insert(Process* process);
     
     // Consumer operation
-    Process remove();
+    Process* remove();
+    
+    // Batch operations
+    int insertBatch(Process** processes, int numProcesses);
+    int removeBatch(Process** processes, int maxCount);
     
     // Check if buffer is empty
     bool isEmpty();
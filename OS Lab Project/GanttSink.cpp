@@ -0,0 +1,49 @@
+#include "GanttSink.h"
+
+using namespace std;
+
+GanttFileSink::GanttFileSink() : file(nullptr), failed(false) {}
+
+GanttFileSink::~GanttFileSink() {
+    if (file) {
+        fclose(file);
+    }
+}
+
+bool GanttFileSink::open(const string& filePath, string& error) {
+    file = fopen(filePath.c_str(), "w");
+    if (!file) {
+        error = "Cannot write Gantt file " + filePath;
+        return false;
+    }
+    path = filePath;
+    failed = false;
+    setvbuf(file, NULL, _IOFBF, 1 << 16);
+    fputs("cpu,pid,start,end\n", file);
+    return true;
+}
+
+bool GanttFileSink::close(string& error) {
+    if (!file) {
+        return true;
+    }
+    if (ferror(file)) failed = true;
+    if (fclose(file) != 0) failed = true;
+    file = nullptr;
+    if (failed) {
+        error = "Error while writing Gantt file " + path;
+    }
+    return !failed;
+}
+
+void GanttFileSink::write(const GanttEntry& entry) {
+    if (file) {
+        fprintf(file, "%d,%d,%d,%d\n", entry.cpu, entry.processID, entry.startTime, entry.endTime);
+    }
+}
+
+void GanttFileSink::flush() {
+    if (file && fflush(file) != 0) {
+        failed = true;
+    }
+}
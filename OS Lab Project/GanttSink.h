@@ -0,0 +1,50 @@
+#ifndef GANTT_SINK_H
+#define GANTT_SINK_H
+
+#include <cstdio>
+#include <functional>
+#include <string>
+#include "Process.h"
+
+// Receives Gantt entries while the scheduler runs. Entries arrive once
+// they can no longer grow, so a sink sees each coalesced slice exactly once;
+// entries of different CPUs may interleave out of start order.
+class GanttSink {
+public:
+    virtual ~GanttSink() {}
+    virtual void write(const GanttEntry& entry) = 0;
+    virtual void flush() {}
+};
+
+// Appends "cpu,pid,start,end" lines to a file through stdio's buffer
+class GanttFileSink : public GanttSink {
+private:
+    FILE* file;
+    std::string path;
+    bool failed;
+
+public:
+    GanttFileSink();
+    ~GanttFileSink();
+
+    bool open(const std::string& filePath, std::string& error);
+
+    // Flush and close; false if any write failed
+    bool close(std::string& error);
+
+    void write(const GanttEntry& entry);
+    void flush();
+};
+
+// Hands every entry to a function, e.g. to count or aggregate slices
+class GanttCallbackSink : public GanttSink {
+private:
+    std::function<void(const GanttEntry&)> callback;
+
+public:
+    explicit GanttCallbackSink(std::function<void(const GanttEntry&)> function) : callback(function) {}
+
+    void write(const GanttEntry& entry) { callback(entry); }
+};
+
+#endif
@@ -0,0 +1,87 @@
+#ifndef INDEXED_HEAP_H
+#define INDEXED_HEAP_H
+
+#include <vector>
+
+// Binary min-heap of process indices 0..capacity-1 that knows where each
+// index sits, so a key can be changed in place. Keys live outside the heap:
+// less(a, b) compares indices, and after a key changes the caller calls
+// update(i) to restore the order (decrease-key or increase-key, O(log n)).
+template <typename Less>
+class IndexedHeap {
+private:
+    std::vector<int> heap;
+    std::vector<int> position;  // Index -> slot in heap, -1 if absent
+    Less less;
+
+    void place(int slot, int index) {
+        heap[slot] = index;
+        position[index] = slot;
+    }
+
+    void siftUp(int slot) {
+        int index = heap[slot];
+        while (slot > 0) {
+            int parent = (slot - 1) / 2;
+            if (!less(index, heap[parent])) break;
+            place(slot, heap[parent]);
+            slot = parent;
+        }
+        place(slot, index);
+    }
+
+    void siftDown(int slot) {
+        int index = heap[slot];
+        int count = heap.size();
+        while (true) {
+            int child = 2 * slot + 1;
+            if (child >= count) break;
+            if (child + 1 < count && less(heap[child + 1], heap[child])) child++;
+            if (!less(heap[child], index)) break;
+            place(slot, heap[child]);
+            slot = child;
+        }
+        place(slot, index);
+    }
+
+public:
+    IndexedHeap(int capacity, Less compare) : position(capacity, -1), less(compare) {
+        heap.reserve(capacity);
+    }
+
+    bool empty() const { return heap.empty(); }
+    int size() const { return heap.size(); }
+    bool contains(int index) const { return position[index] >= 0; }
+    int top() const { return heap[0]; }
+
+    void push(int index) {
+        heap.push_back(index);
+        siftUp(heap.size() - 1);
+    }
+
+    int pop() {
+        int index = heap[0];
+        remove(index);
+        return index;
+    }
+
+    void remove(int index) {
+        int slot = position[index];
+        int last = heap.back();
+        heap.pop_back();
+        position[index] = -1;
+        if (last != index) {
+            place(slot, last);
+            update(last);
+        }
+    }
+
+    // Restore heap order after index's key changed
+    void update(int index) {
+        int slot = position[index];
+        siftUp(slot);
+        siftDown(position[index]);
+    }
+};
+
+#endif
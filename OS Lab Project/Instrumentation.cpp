@@ -0,0 +1,193 @@
+#include "Instrumentation.h"
+#include <pthread.h>
+#include <cstring>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+using namespace std;
+
+void LatencyHistogram::clear() {
+    memset(counts, 0, sizeof(counts));
+    total = 0;
+    sum = 0;
+    maximum = 0;
+}
+
+int LatencyHistogram::bucketOf(uint64_t value) {
+    if (value < (uint64_t)SUB_BUCKETS) {
+        return (int)value;
+    }
+    if (value >> MAX_BITS) {
+        value = (1ULL << MAX_BITS) - 1;
+    }
+    int msb = 63 - __builtin_clzll(value);
+    int level = msb - SUB_BITS;
+    int sub = (int)(value >> level) - SUB_BUCKETS;
+    return SUB_BUCKETS + level * SUB_BUCKETS + sub;
+}
+
+uint64_t LatencyHistogram::highestValueIn(int bucket) {
+    if (bucket < SUB_BUCKETS) {
+        return bucket;
+    }
+    int level = (bucket - SUB_BUCKETS) / SUB_BUCKETS;
+    int sub = (bucket - SUB_BUCKETS) % SUB_BUCKETS;
+    uint64_t lowest = (uint64_t)(SUB_BUCKETS + sub) << level;
+    return lowest + (1ULL << level) - 1;
+}
+
+void LatencyHistogram::record(uint64_t value) {
+    counts[bucketOf(value)]++;
+    total++;
+    sum += value;
+    if (value > maximum) maximum = value;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (int i = 0; i < BUCKETS; i++) {
+        counts[i] += other.counts[i];
+    }
+    total += other.total;
+    sum += other.sum;
+    if (other.maximum > maximum) maximum = other.maximum;
+}
+
+uint64_t LatencyHistogram::percentile(double fraction) const {
+    if (total == 0) {
+        return 0;
+    }
+    uint64_t target = (uint64_t)(fraction * total + 0.999999);
+    if (target < 1) target = 1;
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKETS; i++) {
+        seen += counts[i];
+        if (seen >= target) {
+            uint64_t value = highestValueIn(i);
+            return value < maximum ? value : maximum;
+        }
+    }
+    return maximum;
+}
+
+namespace {
+
+// One thread's samples. Blocks outlive their threads so that report() still
+// sees them; a finished thread's block is handed to the next new thread.
+struct ThreadMetrics {
+    LatencyHistogram histograms[METRIC_COUNT];
+    uint64_t counters[COUNTER_COUNT];
+
+    ThreadMetrics() { memset(counters, 0, sizeof(counters)); }
+};
+
+pthread_mutex_t registryMutex = PTHREAD_MUTEX_INITIALIZER;
+vector<ThreadMetrics*> allBlocks;
+vector<ThreadMetrics*> freeBlocks;
+
+struct ThreadSlot {
+    ThreadMetrics* block;
+
+    ThreadSlot() : block(nullptr) {}
+    ~ThreadSlot() {
+        if (block) {
+            pthread_mutex_lock(&registryMutex);
+            freeBlocks.push_back(block);
+            pthread_mutex_unlock(&registryMutex);
+        }
+    }
+};
+
+thread_local ThreadSlot slot;
+
+ThreadMetrics& localBlock() {
+    if (!slot.block) {
+        pthread_mutex_lock(&registryMutex);
+        if (!freeBlocks.empty()) {
+            slot.block = freeBlocks.back();
+            freeBlocks.pop_back();
+        } else {
+            slot.block = new ThreadMetrics();
+            allBlocks.push_back(slot.block);
+        }
+        pthread_mutex_unlock(&registryMutex);
+    }
+    return *slot.block;
+}
+
+}
+
+void Instrumentation::record(Metric metric, uint64_t nanoseconds) {
+    localBlock().histograms[metric].record(nanoseconds);
+}
+
+void Instrumentation::count(Counter counter, uint64_t amount) {
+    localBlock().counters[counter] += amount;
+}
+
+void Instrumentation::reset() {
+    pthread_mutex_lock(&registryMutex);
+    for (ThreadMetrics* block : allBlocks) {
+        for (int m = 0; m < METRIC_COUNT; m++) {
+            block->histograms[m].clear();
+        }
+        memset(block->counters, 0, sizeof(block->counters));
+    }
+    pthread_mutex_unlock(&registryMutex);
+}
+
+void Instrumentation::report() {
+    static const char* names[METRIC_COUNT] = {
+        "Buffer wait (slot)",
+        "Buffer wait (process)",
+        "Resource lock hold",
+        "Safety check (isSafe)"
+    };
+
+    // Merged on the heap: a histogram is about 9 KB
+    vector<LatencyHistogram> merged(METRIC_COUNT);
+    uint64_t counters[COUNTER_COUNT] = { 0 };
+    pthread_mutex_lock(&registryMutex);
+    for (const ThreadMetrics* block : allBlocks) {
+        for (int m = 0; m < METRIC_COUNT; m++) {
+            merged[m].merge(block->histograms[m]);
+        }
+        for (int c = 0; c < COUNTER_COUNT; c++) {
+            counters[c] += block->counters[c];
+        }
+    }
+    pthread_mutex_unlock(&registryMutex);
+
+    cout << "\n========================================" << endl;
+    cout << "   HOT-PATH LATENCY (microseconds)" << endl;
+    cout << "========================================" << endl;
+    cout << left << setw(23) << "Metric" << right
+         << setw(10) << "Count"
+         << setw(10) << "Mean"
+         << setw(10) << "p50"
+         << setw(10) << "p90"
+         << setw(10) << "p99"
+         << setw(10) << "p99.9"
+         << setw(10) << "Max" << endl;
+    cout << "----------------------------------------" << endl;
+    cout << fixed << setprecision(2);
+    for (int m = 0; m < METRIC_COUNT; m++) {
+        const LatencyHistogram& h = merged[m];
+        cout << left << setw(23) << names[m] << right
+             << setw(10) << h.count()
+             << setw(10) << h.mean() / 1000
+             << setw(10) << h.percentile(0.50) / 1000.0
+             << setw(10) << h.percentile(0.90) / 1000.0
+             << setw(10) << h.percentile(0.99) / 1000.0
+             << setw(10) << h.percentile(0.999) / 1000.0
+             << setw(10) << h.max() / 1000.0 << endl;
+    }
+    cout << left;
+
+    cout << "\nBuffer inserts: " << counters[COUNTER_BUFFER_INSERTS]
+         << ", removes: " << counters[COUNTER_BUFFER_REMOVES] << endl;
+    cout << "Banker requests: " << counters[COUNTER_BANKER_REQUESTS]
+         << " (denied " << counters[COUNTER_BANKER_DENIED]
+         << ", answered from cached safe order " << counters[COUNTER_SAFE_ORDER_HITS] << ")" << endl;
+    cout << "========================================\n" << endl;
+}
@@ -0,0 +1,92 @@
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <stdint.h>
+#include <time.h>
+
+// Hot-path latency histograms and event counters. Each thread records into
+// its own block, so recording is a clock read and an array increment with no
+// sharing; report() merges the blocks. Built only with -DCCP_INSTRUMENT
+// (make INSTRUMENT=1; off by default); otherwise the macros below compile
+// to nothing.
+
+enum Metric {
+    METRIC_BUFFER_WAIT_SLOT,     // Producer waiting for a free buffer slot
+    METRIC_BUFFER_WAIT_PROCESS,  // Consumer waiting for a process
+    METRIC_RESOURCE_LOCK_HOLD,   // Banker resourceMutex held
+    METRIC_SAFETY_CHECK,         // One full Banker isSafe pass
+    METRIC_COUNT
+};
+
+enum Counter {
+    COUNTER_BUFFER_INSERTS,
+    COUNTER_BUFFER_REMOVES,
+    COUNTER_BANKER_REQUESTS,
+    COUNTER_BANKER_DENIED,
+    COUNTER_SAFE_ORDER_HITS,     // Requests answered from the cached safe sequence
+    COUNTER_COUNT
+};
+
+// Log-linear buckets in the style of HdrHistogram: 32 linear sub-buckets per
+// power of two, so any recorded value is reported within about 3%. Values
+// are nanoseconds and saturate at 2^40 (about 18 minutes).
+class LatencyHistogram {
+public:
+    static const int SUB_BITS = 5;
+    static const int SUB_BUCKETS = 1 << SUB_BITS;
+    static const int MAX_BITS = 40;
+    static const int BUCKETS = (MAX_BITS - SUB_BITS + 1) * SUB_BUCKETS;
+
+    LatencyHistogram() { clear(); }
+
+    void clear();
+    void record(uint64_t value);
+    void merge(const LatencyHistogram& other);
+
+    uint64_t count() const { return total; }
+    uint64_t max() const { return maximum; }
+    double mean() const { return total ? (double)sum / total : 0; }
+
+    // Smallest bucket value with at least fraction of the samples at or below it
+    uint64_t percentile(double fraction) const;
+
+private:
+    uint64_t counts[BUCKETS];
+    uint64_t total;
+    uint64_t sum;
+    uint64_t maximum;
+
+    static int bucketOf(uint64_t value);
+    static uint64_t highestValueIn(int bucket);
+};
+
+namespace Instrumentation {
+    inline uint64_t now() {
+        timespec t;
+        clock_gettime(CLOCK_MONOTONIC, &t);
+        return (uint64_t)t.tv_sec * 1000000000ULL + t.tv_nsec;
+    }
+
+    void record(Metric metric, uint64_t nanoseconds);
+    void count(Counter counter, uint64_t amount = 1);
+
+    // Zero every thread's block; call while no instrumented thread runs
+    void reset();
+
+    // Print percentiles for every metric and the counters
+    void report();
+}
+
+#ifdef CCP_INSTRUMENT
+#define INSTRUMENT_START(name) uint64_t name = Instrumentation::now()
+#define INSTRUMENT_MARK(target) ((target) = Instrumentation::now())
+#define INSTRUMENT_RECORD(metric, start) Instrumentation::record(metric, Instrumentation::now() - (start))
+#define INSTRUMENT_COUNT(counter, amount) Instrumentation::count(counter, amount)
+#else
+#define INSTRUMENT_START(name) ((void)0)
+#define INSTRUMENT_MARK(target) ((void)0)
+#define INSTRUMENT_RECORD(metric, start) ((void)0)
+#define INSTRUMENT_COUNT(counter, amount) ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,225 @@
+#include "LockFreeBuffer.h"
+#include "Logger.h"
+#include "Instrumentation.h"
+#include <sched.h>
+
+static void backoff(int& spins) {
+    // Spin briefly, then give the CPU away while the other side catches up
+    if (++spins < 64) {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#endif
+    } else {
+        sched_yield();
+    }
+}
+
+LockFreeBuffer::LockFreeBuffer(int size) : tail(0), head(0) {
+    size_t capacity = 1;
+    while (capacity < (size_t)(size > 0 ? size : 1)) {
+        capacity <<= 1;
+    }
+    mask = capacity - 1;
+    slots = new Slot[capacity];
+    for (size_t i = 0; i < capacity; i++) {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+        slots[i].process = nullptr;
+    }
+}
+
+LockFreeBuffer::~LockFreeBuffer() {
+    // Free anything nobody consumed
+    while (Process* process = tryRemove()) {
+        delete process;
+    }
+    delete[] slots;
+}
+
+bool LockFreeBuffer::tryInsert(Process* process) {
+    size_t pos = tail.load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;) {
+        slot = &slots[pos & mask];
+        size_t seq = slot->sequence.load(std::memory_order_acquire);
+        long diff = (long)seq - (long)pos;
+        if (diff == 0) {
+            // Slot is free for this lap; claim the position
+            if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false;  // Full
+        } else {
+            pos = tail.load(std::memory_order_relaxed);
+        }
+    }
+    
+    slot->process = process;
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+Process* LockFreeBuffer::tryRemove() {
+    size_t pos = head.load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;) {
+        slot = &slots[pos & mask];
+        size_t seq = slot->sequence.load(std::memory_order_acquire);
+        long diff = (long)seq - (long)(pos + 1);
+        if (diff == 0) {
+            // Slot holds data for this lap; claim the position
+            if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return nullptr;  // Empty
+        } else {
+            pos = head.load(std::memory_order_relaxed);
+        }
+    }
+    
+    Process* process = slot->process;
+    slot->sequence.store(pos + mask + 1, std::memory_order_release);
+    return process;
+}
+
+int LockFreeBuffer::tryInsertBatch(Process** processes, int numProcesses) {
+    size_t pos = tail.load(std::memory_order_relaxed);
+    int run;
+    for (;;) {
+        // Count the free slots for this lap starting at pos. They cannot be
+        // taken by anyone else without moving tail past pos first.
+        run = 0;
+        long diff = 0;
+        while (run < numProcesses) {
+            size_t seq = slots[(pos + run) & mask].sequence.load(std::memory_order_acquire);
+            diff = (long)seq - (long)(pos + run);
+            if (diff != 0) break;
+            run++;
+        }
+        
+        if (run == 0) {
+            if (diff < 0) {
+                return 0;  // Full
+            }
+            pos = tail.load(std::memory_order_relaxed);
+        } else if (tail.compare_exchange_weak(pos, pos + run, std::memory_order_relaxed)) {
+            break;
+        }
+    }
+    
+    for (int i = 0; i < run; i++) {
+        Slot& slot = slots[(pos + i) & mask];
+        slot.process = processes[i];
+        slot.sequence.store(pos + i + 1, std::memory_order_release);
+    }
+    return run;
+}
+
+int LockFreeBuffer::tryRemoveBatch(Process** processes, int maxCount) {
+    size_t pos = head.load(std::memory_order_relaxed);
+    int run;
+    for (;;) {
+        // Count the filled slots for this lap starting at pos
+        run = 0;
+        long diff = 0;
+        while (run < maxCount) {
+            size_t seq = slots[(pos + run) & mask].sequence.load(std::memory_order_acquire);
+            diff = (long)seq - (long)(pos + run + 1);
+            if (diff != 0) break;
+            run++;
+        }
+        
+        if (run == 0) {
+            if (diff < 0) {
+                return 0;  // Empty
+            }
+            pos = head.load(std::memory_order_relaxed);
+        } else if (head.compare_exchange_weak(pos, pos + run, std::memory_order_relaxed)) {
+            break;
+        }
+    }
+    
+    for (int i = 0; i < run; i++) {
+        Slot& slot = slots[(pos + i) & mask];
+        processes[i] = slot.process;
+        slot.sequence.store(pos + i + mask + 1, std::memory_order_release);
+    }
+    return run;
+}
+
+void LockFreeBuffer::insert(Process* process) {
+    INSTRUMENT_START(waitStart);
+    int spins = 0;
+    while (!tryInsert(process)) {
+        backoff(spins);
+    }
+    INSTRUMENT_RECORD(METRIC_BUFFER_WAIT_SLOT, waitStart);
+    INSTRUMENT_COUNT(COUNTER_BUFFER_INSERTS, 1);
+    LOG_DEBUG("[PRODUCER] Inserted Process P{} (Priority: {}, Burst: {})",
+              process->processID, process->priority, process->burstTime);
+}
+
+Process* LockFreeBuffer::remove() {
+    Process* process;
+    INSTRUMENT_START(waitStart);
+    int spins = 0;
+    while (!(process = tryRemove())) {
+        backoff(spins);
+    }
+    INSTRUMENT_RECORD(METRIC_BUFFER_WAIT_PROCESS, waitStart);
+    INSTRUMENT_COUNT(COUNTER_BUFFER_REMOVES, 1);
+    LOG_DEBUG("[CONSUMER] Removed Process P{} from buffer", process->processID);
+    return process;
+}
+
+int LockFreeBuffer::insertBatch(Process** processes, int numProcesses) {
+    if (numProcesses > maxBatchSize) numProcesses = maxBatchSize;
+    if (numProcesses <= 0) return 0;
+    
+    INSTRUMENT_START(waitStart);
+    int spins = 0;
+    int inserted;
+    while ((inserted = tryInsertBatch(processes, numProcesses)) == 0) {
+        backoff(spins);
+    }
+    INSTRUMENT_RECORD(METRIC_BUFFER_WAIT_SLOT, waitStart);
+    INSTRUMENT_COUNT(COUNTER_BUFFER_INSERTS, inserted);
+    for (int i = 0; i < inserted; i++) {
+        LOG_DEBUG("[PRODUCER] Inserted Process P{} (Priority: {}, Burst: {})",
+                  processes[i]->processID, processes[i]->priority, processes[i]->burstTime);
+    }
+    return inserted;
+}
+
+int LockFreeBuffer::removeBatch(Process** processes, int maxCount) {
+    if (maxCount > maxBatchSize) maxCount = maxBatchSize;
+    if (maxCount <= 0) return 0;
+    
+    INSTRUMENT_START(waitStart);
+    int spins = 0;
+    int removed;
+    while ((removed = tryRemoveBatch(processes, maxCount)) == 0) {
+        backoff(spins);
+    }
+    INSTRUMENT_RECORD(METRIC_BUFFER_WAIT_PROCESS, waitStart);
+    INSTRUMENT_COUNT(COUNTER_BUFFER_REMOVES, removed);
+    for (int i = 0; i < removed; i++) {
+        LOG_DEBUG("[CONSUMER] Removed Process P{} from buffer", processes[i]->processID);
+    }
+    return removed;
+}
+
+bool LockFreeBuffer::isEmpty() {
+    return size() == 0;
+}
+
+int LockFreeBuffer::size() {
+    size_t h = head.load(std::memory_order_acquire);
+    size_t t = tail.load(std::memory_order_acquire);
+    return t > h ? (int)(t - h) : 0;
+}
+
+int LockFreeBuffer::capacity() const {
+    return mask + 1;
+}
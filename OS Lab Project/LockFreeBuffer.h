@@ -0,0 +1,52 @@
+#ifndef LOCK_FREE_BUFFER_H
+#define LOCK_FREE_BUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include "ProcessBuffer.h"
+
+// Bounded multi-producer/multi-consumer ring buffer without locks. Each slot
+// carries a sequence number that tells producers and consumers whether it is
+// free or filled for the current lap; head and tail sit on separate cache
+// lines so producers and consumers do not false-share.
+class LockFreeBuffer : public ProcessBuffer {
+private:
+    static const size_t CACHE_LINE = 64;
+    
+    struct Slot {
+        std::atomic<size_t> sequence;
+        Process* process;
+    };
+    
+    Slot* slots;
+    size_t mask;  // capacity - 1, capacity is a power of two
+    
+    char padBefore[CACHE_LINE];
+    std::atomic<size_t> tail;  // Next position to fill (producers)
+    char padTail[CACHE_LINE - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> head;  // Next position to drain (consumers)
+    char padHead[CACHE_LINE - sizeof(std::atomic<size_t>)];
+    
+public:
+    // Capacity is rounded up to the next power of two
+    LockFreeBuffer(int size);
+    ~LockFreeBuffer();
+    
+    // Non-blocking variants; return false / nullptr if full / empty
+    bool tryInsert(Process* process);
+    Process* tryRemove();
+    
+    // Claim a run of consecutive slots with a single CAS; return how many
+    int tryInsertBatch(Process** processes, int numProcesses);
+    int tryRemoveBatch(Process** processes, int maxCount);
+    
+    void insert(Process* process);
+    Process* remove();
+    int insertBatch(Process** processes, int numProcesses);
+    int removeBatch(Process** processes, int maxCount);
+    bool isEmpty();
+    int size();
+    int capacity() const;
+};
+
+#endif
@@ -0,0 +1,253 @@
+#include "Logger.h"
+#include <pthread.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+using namespace std;
+
+struct LogRecord {
+    unsigned long long sequence;  // Global order across threads
+    const char* format;
+    int argCount;
+    LogArg args[Logger::MAX_ARGS];
+};
+
+// Single-producer/single-consumer ring owned by one logging thread
+struct LogRing {
+    static const unsigned CAPACITY = 1024;
+
+    LogRecord records[CAPACITY];
+    atomic<unsigned> writeIndex;  // Advanced by the owning thread
+    char pad[64];
+    atomic<unsigned> readIndex;   // Advanced by the writer
+    atomic<bool> released;        // Owning thread has exited
+    atomic<unsigned long> dropped;
+
+    LogRing() : writeIndex(0), readIndex(0), released(false), dropped(0) {}
+};
+
+// Marks the thread's ring as reusable when the thread exits
+struct RingHandle {
+    LogRing* ring;
+    RingHandle() : ring(nullptr) {}
+    ~RingHandle() {
+        if (ring) ring->released.store(true, memory_order_release);
+    }
+};
+
+static LogLevel initialLevel() {
+    LogLevel level = LOG_LEVEL_DEBUG;
+    const char* name = getenv("CCP_LOG_LEVEL");
+    if (name) {
+        Logger::parseLevel(name, level);
+    }
+    return level;
+}
+
+atomic<int> Logger::currentLevel(initialLevel());
+
+static atomic<unsigned long long> nextSequence(0);
+static pthread_mutex_t registryMutex = PTHREAD_MUTEX_INITIALIZER;
+static vector<LogRing*> rings;
+static pthread_mutex_t drainMutex = PTHREAD_MUTEX_INITIALIZER;
+static unsigned long lostRecords = 0;  // Counted from rings as they drain
+
+static pthread_mutex_t writerMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_t writerThread;
+static atomic<bool> writerActive(false);
+
+static thread_local RingHandle localHandle;
+
+static void appendNumber(string& out, long long value) {
+    char digits[24];
+    int len = snprintf(digits, sizeof(digits), "%lld", value);
+    out.append(digits, len);
+}
+
+static void formatRecord(string& out, const LogRecord& record) {
+    int next = 0;
+    for (const char* p = record.format; *p; p++) {
+        if (p[0] == '{' && p[1] == '}' && next < record.argCount) {
+            const LogArg& arg = record.args[next++];
+            if (arg.type == LogArg::INTEGER) {
+                appendNumber(out, arg.integer);
+            } else if (arg.type == LogArg::REAL) {
+                char text[32];
+                int len = snprintf(text, sizeof(text), "%.2f", arg.real);
+                out.append(text, len);
+            } else {
+                out += arg.text ? arg.text : "(null)";
+            }
+            p++;
+        } else {
+            out += *p;
+        }
+    }
+    out += '\n';
+}
+
+// Write out every record currently queued. Returns how many were written.
+static int drainRings() {
+    pthread_mutex_lock(&drainMutex);
+
+    pthread_mutex_lock(&registryMutex);
+    vector<LogRing*> snapshot = rings;
+    pthread_mutex_unlock(&registryMutex);
+
+    vector<unsigned> ends(snapshot.size());
+    vector<pair<unsigned long long, const LogRecord*> > pending;
+    for (size_t i = 0; i < snapshot.size(); i++) {
+        LogRing* ring = snapshot[i];
+        unsigned start = ring->readIndex.load(memory_order_relaxed);
+        ends[i] = ring->writeIndex.load(memory_order_acquire);
+        for (unsigned pos = start; pos != ends[i]; pos++) {
+            const LogRecord& record = ring->records[pos % LogRing::CAPACITY];
+            pending.push_back(make_pair(record.sequence, &record));
+        }
+    }
+
+    // Merge threads back into the order the calls were made
+    sort(pending.begin(), pending.end());
+    string out;
+    for (size_t i = 0; i < pending.size(); i++) {
+        formatRecord(out, *pending[i].second);
+    }
+
+    // Slots may be reused only after they have been formatted
+    for (size_t i = 0; i < snapshot.size(); i++) {
+        snapshot[i]->readIndex.store(ends[i], memory_order_release);
+        lostRecords += snapshot[i]->dropped.exchange(0, memory_order_relaxed);
+    }
+
+    if (!out.empty()) {
+        fwrite(out.data(), 1, out.size(), stdout);
+        fflush(stdout);
+    }
+
+    pthread_mutex_unlock(&drainMutex);
+    return pending.size();
+}
+
+static void* writerLoop(void*) {
+    while (writerActive.load(memory_order_acquire)) {
+        if (drainRings() == 0) {
+            usleep(1000);
+        }
+    }
+    drainRings();
+    return NULL;
+}
+
+// Runs on every exit path (return from main, exit()) before the rings are
+// destroyed, since it is registered after they were constructed
+static void stopWriterAtExit() {
+    Logger::shutdown();
+}
+
+static void startWriter() {
+    static bool exitHandlerRegistered = false;
+    pthread_mutex_lock(&writerMutex);
+    if (!writerActive.load(memory_order_relaxed)) {
+        if (!exitHandlerRegistered) {
+            atexit(stopWriterAtExit);
+            exitHandlerRegistered = true;
+        }
+        writerActive.store(true, memory_order_release);
+        pthread_create(&writerThread, NULL, writerLoop, NULL);
+    }
+    pthread_mutex_unlock(&writerMutex);
+}
+
+static LogRing* localRing() {
+    if (localHandle.ring) {
+        return localHandle.ring;
+    }
+
+    pthread_mutex_lock(&registryMutex);
+    LogRing* ring = nullptr;
+    for (LogRing* candidate : rings) {
+        // Reuse a ring left behind by an exited thread once it is drained
+        if (candidate->released.load(memory_order_acquire) &&
+            candidate->readIndex.load(memory_order_acquire) ==
+            candidate->writeIndex.load(memory_order_relaxed)) {
+            candidate->released.store(false, memory_order_relaxed);
+            ring = candidate;
+            break;
+        }
+    }
+    if (!ring) {
+        ring = new LogRing();
+        rings.push_back(ring);
+    }
+    pthread_mutex_unlock(&registryMutex);
+
+    localHandle.ring = ring;
+    return ring;
+}
+
+void Logger::append(LogLevel level, const char* format, const LogArg* args, int argCount) {
+    LogRing* ring = localRing();
+    if (!writerActive.load(memory_order_relaxed)) {
+        startWriter();
+    }
+
+    unsigned pos = ring->writeIndex.load(memory_order_relaxed);
+    if (pos - ring->readIndex.load(memory_order_acquire) >= LogRing::CAPACITY) {
+        ring->dropped.fetch_add(1, memory_order_relaxed);
+        return;
+    }
+
+    LogRecord& record = ring->records[pos % LogRing::CAPACITY];
+    record.sequence = nextSequence.fetch_add(1, memory_order_relaxed);
+    record.format = format;
+    record.argCount = min(argCount, (int)MAX_ARGS);
+    for (int i = 0; i < record.argCount; i++) {
+        record.args[i] = args[i];
+    }
+    ring->writeIndex.store(pos + 1, memory_order_release);
+}
+
+void Logger::setLevel(LogLevel level) {
+    currentLevel.store(level, memory_order_relaxed);
+}
+
+LogLevel Logger::getLevel() {
+    return (LogLevel)currentLevel.load(memory_order_relaxed);
+}
+
+bool Logger::parseLevel(const char* name, LogLevel& level) {
+    static const char* names[] = { "debug", "info", "warn", "error", "silent" };
+    for (int i = 0; i <= LOG_LEVEL_SILENT; i++) {
+        if (strcmp(name, names[i]) == 0) {
+            level = (LogLevel)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+void Logger::flush() {
+    drainRings();
+}
+
+void Logger::shutdown() {
+    pthread_mutex_lock(&writerMutex);
+    if (writerActive.load(memory_order_relaxed)) {
+        writerActive.store(false, memory_order_release);
+        pthread_join(writerThread, NULL);
+    }
+    pthread_mutex_unlock(&writerMutex);
+    drainRings();
+}
+
+unsigned long Logger::droppedCount() {
+    pthread_mutex_lock(&drainMutex);
+    unsigned long count = lostRecords;
+    pthread_mutex_unlock(&drainMutex);
+    return count;
+}
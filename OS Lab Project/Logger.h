@@ -0,0 +1,79 @@
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <atomic>
+
+enum LogLevel {
+    LOG_LEVEL_DEBUG = 0,
+    LOG_LEVEL_INFO,
+    LOG_LEVEL_WARN,
+    LOG_LEVEL_ERROR,
+    LOG_LEVEL_SILENT
+};
+
+// One captured argument. Strings are stored by pointer, so only pass string
+// literals or other text that outlives the program's logging.
+struct LogArg {
+    enum Type { INTEGER, REAL, TEXT } type;
+    union {
+        long long integer;
+        double real;
+        const char* text;
+    };
+};
+
+inline LogArg makeLogArg(long long value) { LogArg a; a.type = LogArg::INTEGER; a.integer = value; return a; }
+inline LogArg makeLogArg(int value) { return makeLogArg((long long)value); }
+inline LogArg makeLogArg(long value) { return makeLogArg((long long)value); }
+inline LogArg makeLogArg(unsigned value) { return makeLogArg((long long)value); }
+inline LogArg makeLogArg(unsigned long value) { return makeLogArg((long long)value); }
+inline LogArg makeLogArg(double value) { LogArg a; a.type = LogArg::REAL; a.real = value; return a; }
+inline LogArg makeLogArg(const char* value) { LogArg a; a.type = LogArg::TEXT; a.text = value; return a; }
+
+// Asynchronous logger. Each thread appends fixed-size records to its own
+// lock-free ring; a background writer formats and prints them. The format
+// string uses "{}" placeholders and is only expanded by the writer, so a log
+// call costs a handful of stores. Records are dropped (and counted) rather
+// than blocking when a ring is full.
+class Logger {
+public:
+    static const int MAX_ARGS = 6;
+
+    static void setLevel(LogLevel level);
+    static LogLevel getLevel();
+    static bool enabled(LogLevel level) {
+        return level >= currentLevel.load(std::memory_order_relaxed);
+    }
+
+    // Parse "debug", "info", "warn", "error" or "silent"; false if unknown
+    static bool parseLevel(const char* name, LogLevel& level);
+
+    template <typename... Args>
+    static void log(LogLevel level, const char* format, Args... args) {
+        LogArg packed[] = { makeLogArg(args)..., makeLogArg(0) };
+        append(level, format, packed, sizeof...(Args));
+    }
+
+    // Write out everything queued so far, from every thread
+    static void flush();
+
+    // Flush and stop the background writer. Also runs at exit, so calling
+    // it is only needed to stop the writer early.
+    static void shutdown();
+
+    // Records lost because a ring was full
+    static unsigned long droppedCount();
+
+private:
+    static std::atomic<int> currentLevel;
+    static void append(LogLevel level, const char* format, const LogArg* args, int argCount);
+};
+
+#define LOG_AT(level, ...) \
+    do { if (Logger::enabled(level)) Logger::log(level, __VA_ARGS__); } while (0)
+#define LOG_DEBUG(...) LOG_AT(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#define LOG_INFO(...)  LOG_AT(LOG_LEVEL_INFO, __VA_ARGS__)
+#define LOG_WARN(...)  LOG_AT(LOG_LEVEL_WARN, __VA_ARGS__)
+#define LOG_ERROR(...) LOG_AT(LOG_LEVEL_ERROR, __VA_ARGS__)
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef ONLINE_STATISTICS_H
+#define ONLINE_STATISTICS_H
+
+#include "Process.h"
+#include "Instrumentation.h"
+
+// Per-process and CPU figures folded in as the schedule runs, in constant
+// memory: running sums for the averages and log-linear histograms (exact
+// below 32, within about 3% above) for the percentiles.
+class OnlineStatistics {
+private:
+    long completedCount;
+    double waitingSum;
+    double turnaroundSum;
+    double responseSum;
+    double shareSum;          // Sum and sum of squares of burst / turnaround,
+    double shareSquares;      // for Jain's fairness index
+    int lastCompletion;
+    long busy;
+    long switches;
+    LatencyHistogram waitingHistogram;
+    LatencyHistogram turnaroundHistogram;
+    LatencyHistogram responseHistogram;
+
+    static uint64_t clamp(int value) { return value > 0 ? value : 0; }
+
+public:
+    OnlineStatistics() { clear(); }
+
+    void clear() {
+        completedCount = 0;
+        waitingSum = 0;
+        turnaroundSum = 0;
+        responseSum = 0;
+        shareSum = 0;
+        shareSquares = 0;
+        lastCompletion = 0;
+        busy = 0;
+        switches = 0;
+        waitingHistogram.clear();
+        turnaroundHistogram.clear();
+        responseHistogram.clear();
+    }
+
+    // A completed process; startTime must be its first dispatch
+    void add(const Process& p) {
+        int response = p.startTime - p.arrivalTime;
+        double share = p.turnaroundTime > 0 ? (double)p.burstTime / p.turnaroundTime : 1.0;
+        completedCount++;
+        waitingSum += p.waitingTime;
+        turnaroundSum += p.turnaroundTime;
+        responseSum += response;
+        shareSum += share;
+        shareSquares += share * share;
+        if (p.completionTime > lastCompletion) lastCompletion = p.completionTime;
+        waitingHistogram.record(clamp(p.waitingTime));
+        turnaroundHistogram.record(clamp(p.turnaroundTime));
+        responseHistogram.record(clamp(response));
+    }
+
+    // CPU time handed out; switched when the CPU last ran a different process
+    void addSlice(int length, bool switched) {
+        busy += length;
+        if (switched) switches++;
+    }
+
+    long completed() const { return completedCount; }
+    double totalWaiting() const { return waitingSum; }
+    double totalTurnaround() const { return turnaroundSum; }
+    double totalResponse() const { return responseSum; }
+    int makespan() const { return lastCompletion; }
+    long busyTime() const { return busy; }
+    long contextSwitches() const { return switches; }
+
+    // Completed processes per time unit
+    double throughput() const { return lastCompletion > 0 ? (double)completedCount / lastCompletion : 0; }
+
+    // Busy share of cpus CPUs over the makespan
+    double utilization(int cpus) const {
+        return lastCompletion > 0 ? (double)busy / ((double)lastCompletion * cpus) : 0;
+    }
+
+    // (sum x)^2 / (n * sum x^2) over x = burst / turnaround: 1 when every
+    // process got the same share of its time in the system, 1/n at worst
+    double fairness() const {
+        return shareSquares > 0 ? shareSum * shareSum / (completedCount * shareSquares) : 1.0;
+    }
+
+    const LatencyHistogram& waiting() const { return waitingHistogram; }
+    const LatencyHistogram& turnaround() const { return turnaroundHistogram; }
+    const LatencyHistogram& response() const { return responseHistogram; }
+};
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef PACING_CLOCK_H
+#define PACING_CLOCK_H
+
+#include <unistd.h>
+
+// Per-thread clock behind the producer and consumer pauses. In real mode
+// pause() sleeps. In virtual mode it only advances this thread's simulated
+// time, so a run goes at CPU speed while each thread still takes the same
+// sequence of delays; a VirtualTimeline moves it forward across buffer
+// waits.
+class PacingClock {
+private:
+    bool simulated;
+    long long elapsedUs;
+
+public:
+    // Simulated time per scheduler time unit
+    static const int TICK_US = 100000;
+
+    explicit PacingClock(bool virtualTime) : simulated(virtualTime), elapsedUs(0) {}
+
+    void pause(int microseconds) {
+        if (simulated) {
+            elapsedUs += microseconds;
+        } else {
+            usleep(microseconds);
+        }
+    }
+
+    // Jump forward to a later simulated time, e.g. after waiting on the buffer
+    void advanceTo(long long microseconds) {
+        if (microseconds > elapsedUs) elapsedUs = microseconds;
+    }
+
+    bool isVirtual() const { return simulated; }
+    long long elapsed() const { return elapsedUs; }
+
+    // Current simulated time in scheduler time units
+    int ticks() const { return (int)(elapsedUs / TICK_US); }
+};
+
+#endif
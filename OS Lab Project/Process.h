@@ -32,6 +32,7 @@ struct GanttEntry {
     int processID;
     int startTime;
     int endTime;
+    int cpu;  // CPU that ran the slice, 0 on a single CPU
 };
 
 #endif
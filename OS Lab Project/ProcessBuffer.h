@@ -0,0 +1,43 @@
+#ifndef PROCESS_BUFFER_H
+#define PROCESS_BUFFER_H
+
+#include "Process.h"
+
+// Bounded producer-consumer buffer of processes. insert blocks while the
+// buffer is full and remove blocks while it is empty. Processes are handed
+// over by pointer, so a transfer never copies or allocates.
+class ProcessBuffer {
+protected:
+    int maxBatchSize;  // Upper bound on processes moved per batch call
+    
+public:
+    ProcessBuffer() : maxBatchSize(16) {}
+    virtual ~ProcessBuffer() {}
+    
+    // Producer operation; the buffer takes ownership of the process
+    virtual void insert(Process* process) = 0;
+    
+    // Consumer operation; the caller takes ownership of the process
+    virtual Process* remove() = 0;
+    
+    // Batch producer operation: blocks until at least one slot is free, then
+    // inserts up to numProcesses processes (capped by the max batch size) under a
+    // single acquisition. Returns how many were taken.
+    virtual int insertBatch(Process** processes, int numProcesses) = 0;
+    
+    // Batch consumer operation: blocks until at least one process is there,
+    // then removes up to maxCount (capped by the max batch size) at once.
+    // Returns how many were written to processes.
+    virtual int removeBatch(Process** processes, int maxCount) = 0;
+    
+    void setMaxBatchSize(int size) { maxBatchSize = (size > 0) ? size : 1; }
+    int getMaxBatchSize() const { return maxBatchSize; }
+    
+    // Check if buffer is empty
+    virtual bool isEmpty() = 0;
+    
+    // Get current buffer size
+    virtual int size() = 0;
+};
+
+#endif
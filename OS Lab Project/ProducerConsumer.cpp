@@ -1,82 +1,141 @@
 #include "ProducerConsumer.h"
-#include <iostream>
-#include <unistd.h>
-#include <cstdlib>
+#include "Logger.h"
+#include "PacingClock.h"
+#include <vector>
+#include <algorithm>
 
 using namespace std;
 
-Process generateRandomProcess(int processID, int numResources) {
-    Process p;
-    p.processID = processID;
-    p.arrivalTime = 0;
-    p.burstTime = (rand() % 10) + 1;
-    p.priority = (rand() % 5) + 1;
-    
-    p.resourceRequirements.resize(numResources);
-    for (int i = 0; i < numResources; i++) {
-        p.resourceRequirements[i] = (rand() % 5) + 1;
-    }
-    
-    p.remainingTime = p.burstTime;
-    p.hasStarted = false;
-    p.startTime = -1;
-    p.isBlocked = false;
-    
-    return p;
-}
-
 void* producerThread(void* args) {
     ProducerArgs* pArgs = (ProducerArgs*)args;
+    int batchSize = (pArgs->batchSize > 0) ? pArgs->batchSize : 1;
+    vector<Process*> burst(batchSize);
+    
+    // Private stream: what this producer generates does not depend on how
+    // the threads interleave
+    WorkloadModel::Stream stream(Random::forStream(pArgs->seed, pArgs->producerID),
+                                 pArgs->numProducers);
+    PacingClock clock(pArgs->virtualTime);
     
-    cout << "\n[PRODUCER " << pArgs->producerID << "] Started" << endl;
+    // Without an arrival model, the virtual clock says when processes arrive
+    bool stampArrivals = pArgs->virtualTime && !pArgs->workload->hasArrivals();
     
-    for (int i = 0; i < pArgs->numProcesses; i++) {
-        pthread_mutex_lock(pArgs->idMutex);
-        int processID = (*pArgs->nextProcessID)++;
-        pthread_mutex_unlock(pArgs->idMutex);
+    LOG_INFO("[PRODUCER {}] Started", pArgs->producerID);
+    
+    for (int i = 0; i < pArgs->numProcesses; ) {
+        int burstSize = min(batchSize, pArgs->numProcesses - i);
         
-        Process process = generateRandomProcess(processID, pArgs->numResources);
+        int firstID = pArgs->firstProcessID + i;
         
-        cout << "[PRODUCER " << pArgs->producerID << "] Generated Process P" 
-             << process.processID << " (Priority: " << process.priority 
-             << ", Burst: " << process.burstTime << ")" << endl;
+        for (int j = 0; j < burstSize; j++) {
+            // Allocated once here; from now on only the pointer moves
+            burst[j] = new Process(pArgs->workload->generate(firstID + j, pArgs->numResources, stream));
+            if (stampArrivals) {
+                burst[j]->arrivalTime = clock.ticks();
+            }
+            
+            LOG_INFO("[PRODUCER {}] Generated Process P{} (Priority: {}, Burst: {})",
+                     pArgs->producerID, burst[j]->processID, burst[j]->priority,
+                     burst[j]->burstTime);
+        }
         
-        pArgs->buffer->insert(process);
+        if (pArgs->timeline) {
+            // Simulated time decides whether the buffer is full; the insert
+            // itself never blocks, and a wait moves this producer's clock on
+            long long now = clock.elapsed();
+            int inserted = 0;
+            while (inserted < burstSize) {
+                int last = inserted + pArgs->timeline->beginInsert(pArgs->timelineID, now, burstSize - inserted);
+                while (inserted < last) {
+                    inserted += pArgs->buffer->insertBatch(&burst[inserted], last - inserted);
+                }
+                pArgs->timeline->end(pArgs->timelineID);
+            }
+            clock.advanceTo(now);
+        } else if (burstSize == 1) {
+            pArgs->buffer->insert(burst[0]);
+        } else {
+            // The buffer may take only part of the burst if it is nearly full
+            int inserted = 0;
+            while (inserted < burstSize) {
+                inserted += pArgs->buffer->insertBatch(&burst[inserted], burstSize - inserted);
+            }
+        }
+        i += burstSize;
         
-        usleep((rand() % 500000) + 100000);
+        clock.pause(stream.random.uniform(100000, 599999));
     }
     
-    cout << "[PRODUCER " << pArgs->producerID << "] Finished producing" << endl;
+    if (pArgs->timeline) {
+        pArgs->timeline->finish(pArgs->timelineID);
+    }
+    LOG_INFO("[PRODUCER {}] Finished producing", pArgs->producerID);
     
     return NULL;
 }
 
+// Reserve up to wanted of the unclaimed processes; returns how many. A
+// consumer only waits on the buffer for processes it has claimed, so none
+// blocks forever once the last process has been taken.
+static int claimProcesses(atomic<int>* unclaimed, int wanted) {
+    int available = unclaimed->load(memory_order_relaxed);
+    while (available > 0 &&
+           !unclaimed->compare_exchange_weak(available, available - min(wanted, available),
+                                             memory_order_relaxed)) {
+    }
+    return available > 0 ? min(wanted, available) : 0;
+}
+
 void* consumerThread(void* args) {
     ConsumerArgs* cArgs = (ConsumerArgs*)args;
+    int batchSize = (cArgs->batchSize > 0) ? cArgs->batchSize : 1;
+    vector<Process*> batch(batchSize);
+    Random random = Random::forStream(cArgs->seed, cArgs->stream);
+    PacingClock clock(cArgs->virtualTime);
     
-    cout << "\n[CONSUMER] Started - waiting for processes..." << endl;
-    
-    int processesConsumed = 0;
+    LOG_INFO("[CONSUMER {}] Started - waiting for processes...", cArgs->consumerID);
     
-    while (processesConsumed < cArgs->totalProcesses) {
-        Process process = cArgs->buffer->remove();
+    while (true) {
+        // In virtual time the claim waits for processes to be there, and
+        // moves this consumer's clock on while it does
+        long long now = clock.elapsed();
+        int claimed = cArgs->timeline
+            ? cArgs->timeline->beginRemove(cArgs->timelineID, now, batchSize, cArgs->unclaimed)
+            : claimProcesses(cArgs->unclaimed, batchSize);
+        if (claimed == 0) {
+            break;
+        }
         
-        Process* heapProcess = new Process(process);
-        cArgs->scheduler->addProcess(heapProcess);
-        processesConsumed++;
+        int received = 0;
+        while (received < claimed) {
+            if (claimed - received == 1) {
+                batch[received++] = cArgs->buffer->remove();
+            } else {
+                received += cArgs->buffer->removeBatch(&batch[received], claimed - received);
+            }
+        }
+        if (cArgs->timeline) {
+            cArgs->timeline->end(cArgs->timelineID);
+            clock.advanceTo(now);
+        }
         
-        cout << "[CONSUMER] Added Process P" << process.processID 
-             << " to scheduler (" << processesConsumed << "/" 
-             << cArgs->totalProcesses << ")" << endl;
+        // The shard is private to this consumer, so no lock is taken here
+        for (int j = 0; j < received; j++) {
+            cArgs->shard->push_back(batch[j]);
+            
+            LOG_INFO("[CONSUMER {}] Took Process P{} ({} so far, {} in total)",
+                     cArgs->consumerID, batch[j]->processID, (int)cArgs->shard->size(),
+                     cArgs->totalProcesses);
+        }
         
-        usleep((rand() % 300000) + 50000);
+        clock.pause(random.uniform(50000, 349999));
     }
     
     pthread_mutex_lock(cArgs->finishMutex);
-    *cArgs->finished = true;
+    (*cArgs->consumersFinished)++;
     pthread_mutex_unlock(cArgs->finishMutex);
     
-    cout << "[CONSUMER] Finished consuming all processes" << endl;
+    LOG_INFO("[CONSUMER {}] Finished consuming", cArgs->consumerID);
     
     return NULL;
 }
@@ -2,28 +2,45 @@
 #define PRODUCER_CONSUMER_H
 
 #include <pthread.h>
-#include "BoundedBuffer.h"
-#include "Scheduler.h"
+#include <stdint.h>
+#include <atomic>
+#include <vector>
+#include "ProcessBuffer.h"
+#include "WorkloadModel.h"
+#include "VirtualTimeline.h"
 
 struct ProducerArgs {
     int producerID;
     int numProcesses;
-    BoundedBuffer* buffer;
-    int* nextProcessID;
-    pthread_mutex_t* idMutex;
+    ProcessBuffer* buffer;
+    int firstProcessID;  // IDs firstProcessID .. firstProcessID + numProcesses - 1
+    uint64_t seed;       // Master seed; the producer uses stream producerID
+    const WorkloadModel* workload;
+    int numProducers;    // Producers sharing the workload's arrival rate
     int numResources;
+    int batchSize;  // Processes generated per burst
+    bool virtualTime;  // Pauses advance a simulated clock instead of sleeping
+    VirtualTimeline* timeline;  // Virtual time: orders buffer operations, else nullptr
+    int timelineID;
 };
 
 struct ConsumerArgs {
-    BoundedBuffer* buffer;
-    Scheduler* scheduler;
+    int consumerID;
+    ProcessBuffer* buffer;
+    std::vector<Process*>* shard;   // This consumer's processes, merged after join
+    std::atomic<int>* unclaimed;    // Processes no consumer has claimed yet
     int totalProcesses;
-    bool* finished;
+    int* consumersFinished;
     pthread_mutex_t* finishMutex;
+    int batchSize;  // Max processes taken from the buffer at once
+    uint64_t seed;  // Master seed; the consumer uses stream `stream`
+    int stream;
+    bool virtualTime;
+    VirtualTimeline* timeline;
+    int timelineID;
 };
 
 void* producerThread(void* args);
 void* consumerThread(void* args);
-Process generateRandomProcess(int processID, int numResources);
 
 #endif
@@ -0,0 +1,89 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <stdint.h>
+
+// xoshiro256** generator. Each thread owns its own instance, so drawing a
+// number is a few register operations with no shared state. Streams derived
+// from one master seed with forStream never overlap in practice: stream k
+// starts 2^128 * k draws into the master sequence.
+class Random {
+private:
+    uint64_t s[4];
+
+    static uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    // splitmix64, used to spread a 64-bit seed over the 256-bit state
+    static uint64_t splitmix(uint64_t& x) {
+        uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+public:
+    explicit Random(uint64_t seed = 0) { reseed(seed); }
+
+    void reseed(uint64_t seed) {
+        for (int i = 0; i < 4; i++) {
+            s[i] = splitmix(seed);
+        }
+    }
+
+    uint64_t next() {
+        uint64_t result = rotl(s[1] * 5, 7) * 9;
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    // Advance by 2^128 draws
+    void jump() {
+        static const uint64_t JUMP[] = { 0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+                                         0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL };
+        uint64_t t[4] = { 0, 0, 0, 0 };
+        for (int i = 0; i < 4; i++) {
+            for (int b = 0; b < 64; b++) {
+                if (JUMP[i] & (1ULL << b)) {
+                    for (int j = 0; j < 4; j++) t[j] ^= s[j];
+                }
+                next();
+            }
+        }
+        for (int j = 0; j < 4; j++) s[j] = t[j];
+    }
+
+    // Independent generator number `stream` of the master seed
+    static Random forStream(uint64_t masterSeed, int stream) {
+        Random random(masterSeed);
+        for (int i = 0; i < stream; i++) {
+            random.jump();
+        }
+        return random;
+    }
+
+    // Uniform integer in [low, high], without modulo bias
+    int uniform(int low, int high) {
+        uint64_t range = (uint64_t)((int64_t)high - low) + 1;
+        uint64_t limit = UINT64_MAX - UINT64_MAX % range;
+        uint64_t value;
+        do {
+            value = next();
+        } while (value >= limit);
+        return low + (int)(value % range);
+    }
+
+    // Uniform double in [0, 1)
+    double uniformReal() {
+        return (next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+};
+
+#endif
@@ -0,0 +1,127 @@
+#include "ResourceKernel.h"
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define RESOURCE_KERNEL_X86 1
+#include <immintrin.h>
+#endif
+
+static bool fitsScalar(const int* need, const int* work, int count) {
+    for (int i = 0; i < count; i++) {
+        if (need[i] > work[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void addScalar(int* work, const int* allocation, int count) {
+    for (int i = 0; i < count; i++) {
+        work[i] += allocation[i];
+    }
+}
+
+#ifdef RESOURCE_KERNEL_X86
+
+__attribute__((target("sse2")))
+static bool fitsSSE2(const int* need, const int* work, int count) {
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i n = _mm_loadu_si128((const __m128i*)(need + i));
+        __m128i w = _mm_loadu_si128((const __m128i*)(work + i));
+        if (_mm_movemask_epi8(_mm_cmpgt_epi32(n, w)) != 0) {
+            return false;
+        }
+    }
+    return fitsScalar(need + i, work + i, count - i);
+}
+
+__attribute__((target("sse2")))
+static void addSSE2(int* work, const int* allocation, int count) {
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i w = _mm_loadu_si128((const __m128i*)(work + i));
+        __m128i a = _mm_loadu_si128((const __m128i*)(allocation + i));
+        _mm_storeu_si128((__m128i*)(work + i), _mm_add_epi32(w, a));
+    }
+    addScalar(work + i, allocation + i, count - i);
+}
+
+__attribute__((target("avx2")))
+static bool fitsAVX2(const int* need, const int* work, int count) {
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i n = _mm256_loadu_si256((const __m256i*)(need + i));
+        __m256i w = _mm256_loadu_si256((const __m256i*)(work + i));
+        if (!_mm256_testz_si256(_mm256_cmpgt_epi32(n, w), _mm256_set1_epi32(-1))) {
+            return false;
+        }
+    }
+    return fitsSSE2(need + i, work + i, count - i);
+}
+
+__attribute__((target("avx2")))
+static void addAVX2(int* work, const int* allocation, int count) {
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i w = _mm256_loadu_si256((const __m256i*)(work + i));
+        __m256i a = _mm256_loadu_si256((const __m256i*)(allocation + i));
+        _mm256_storeu_si256((__m256i*)(work + i), _mm256_add_epi32(w, a));
+    }
+    addSSE2(work + i, allocation + i, count - i);
+}
+
+#endif
+
+static const ResourceKernel scalarKernel = { "scalar", fitsScalar, addScalar };
+#ifdef RESOURCE_KERNEL_X86
+static const ResourceKernel sse2Kernel = { "sse2", fitsSSE2, addSSE2 };
+static const ResourceKernel avx2Kernel = { "avx2", fitsAVX2, addAVX2 };
+#endif
+
+const ResourceKernel* findResourceKernel(const char* name) {
+    if (strcmp(name, "scalar") == 0) {
+        return &scalarKernel;
+    }
+#ifdef RESOURCE_KERNEL_X86
+    __builtin_cpu_init();
+    if (strcmp(name, "sse2") == 0 && __builtin_cpu_supports("sse2")) {
+        return &sse2Kernel;
+    }
+    if (strcmp(name, "avx2") == 0 && __builtin_cpu_supports("avx2")) {
+        return &avx2Kernel;
+    }
+#endif
+    return nullptr;
+}
+
+static const ResourceKernel& selectResourceKernel() {
+    const char* forced = getenv("CCP_RESOURCE_KERNEL");
+    if (forced) {
+        const ResourceKernel* kernel = findResourceKernel(forced);
+        if (kernel) {
+            return *kernel;
+        }
+    }
+    const char* preferred[] = { "avx2", "sse2" };
+    for (const char* name : preferred) {
+        const ResourceKernel* kernel = findResourceKernel(name);
+        if (kernel) {
+            return *kernel;
+        }
+    }
+    return scalarKernel;
+}
+
+const ResourceKernel& activeResourceKernel() {
+    static const ResourceKernel& kernel = selectResourceKernel();
+    return kernel;
+}
+
+const ResourceKernel& resourceKernelFor(int count) {
+    if (count < 4 && !getenv("CCP_RESOURCE_KERNEL")) {
+        return scalarKernel;
+    }
+    return activeResourceKernel();
+}
@@ -0,0 +1,26 @@
+#ifndef RESOURCE_KERNEL_H
+#define RESOURCE_KERNEL_H
+
+// Vector kernels for the Banker's safety check. Each kernel works on rows of
+// `count` ints; the best one supported by the CPU is picked at runtime.
+typedef bool (*ResourceFitsFn)(const int* need, const int* work, int count);
+typedef void (*ResourceAddFn)(int* work, const int* allocation, int count);
+
+struct ResourceKernel {
+    const char* name;
+    ResourceFitsFn fits;  // true if need[i] <= work[i] for every i
+    ResourceAddFn add;    // work[i] += allocation[i]
+};
+
+// Kernel selected for this CPU (AVX2, then SSE2, then scalar). Setting
+// CCP_RESOURCE_KERNEL=scalar|sse2|avx2 overrides the choice.
+const ResourceKernel& activeResourceKernel();
+
+// Kernel to use for rows of `count` ints; narrow rows stay scalar since the
+// vector setup costs more than it saves below one SSE register
+const ResourceKernel& resourceKernelFor(int count);
+
+// Look up a kernel by name; returns nullptr if it is unknown or unsupported
+const ResourceKernel* findResourceKernel(const char* name);
+
+#endif
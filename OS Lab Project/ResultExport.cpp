@@ -0,0 +1,372 @@
+#include "ResultExport.h"
+#include <cstdio>
+#include <unordered_map>
+
+using namespace std;
+
+// A stdio file with a large buffer and the handful of formatters the exports
+// need. Integers, which make up nearly all of the output, are formatted by
+// hand rather than through iostreams or printf.
+class ExportFile {
+private:
+    FILE* file;
+    string path;
+
+public:
+    ExportFile() : file(nullptr) {}
+    ~ExportFile() {
+        if (file) fclose(file);
+    }
+
+    bool open(const string& filePath, const char* what, string& error) {
+        file = fopen(filePath.c_str(), "w");
+        if (!file) {
+            error = string("Cannot write ") + what + " file " + filePath;
+            return false;
+        }
+        path = filePath;
+        setvbuf(file, NULL, _IOFBF, 1 << 16);
+        return true;
+    }
+
+    bool close(const char* what, string& error) {
+        bool written = !ferror(file);
+        if (fclose(file) != 0) written = false;
+        file = nullptr;
+        if (!written) {
+            error = string("Error while writing ") + what + " file " + path;
+        }
+        return written;
+    }
+
+    void text(const char* s) { fputs(s, file); }
+    void text(const string& s) { fwrite(s.data(), 1, s.size(), file); }
+    void character(char c) { putc(c, file); }
+
+    void integer(long value) {
+        char digits[24];
+        int length = 0;
+        unsigned long magnitude = value < 0 ? 0UL - (unsigned long)value : (unsigned long)value;
+        do {
+            digits[sizeof(digits) - 1 - length++] = '0' + magnitude % 10;
+            magnitude /= 10;
+        } while (magnitude);
+        if (value < 0) digits[sizeof(digits) - 1 - length++] = '-';
+        fwrite(digits + sizeof(digits) - length, 1, length, file);
+    }
+
+    // Round-trips exactly, so a reader gets back the value that was computed
+    void number(double value) {
+        char digits[32];
+        int length = snprintf(digits, sizeof(digits), "%.17g", value);
+        fwrite(digits, 1, length, file);
+    }
+
+    // values separated by commas, as in a CSV row or a JSON array
+    void integers(const int* values, int count) {
+        for (int i = 0; i < count; i++) {
+            if (i > 0) character(',');
+            integer(values[i]);
+        }
+    }
+
+    void jsonArray(const int* values, int count) {
+        character('[');
+        integers(values, count);
+        character(']');
+    }
+};
+
+// One figure of displayStatistics; counts and times are written as integers
+struct StatisticValue {
+    const char* name;
+    bool integral;
+    long integer;
+    double real;
+};
+
+static StatisticValue integerStatistic(const char* name, long value) {
+    StatisticValue statistic = { name, true, value, 0 };
+    return statistic;
+}
+
+static StatisticValue realStatistic(const char* name, double value) {
+    StatisticValue statistic = { name, false, 0, value };
+    return statistic;
+}
+
+static void writeStatistic(ExportFile& file, const StatisticValue& statistic) {
+    if (statistic.integral) {
+        file.integer(statistic.integer);
+    } else {
+        file.number(statistic.real);
+    }
+}
+
+// The figures of displayStatistics, in display order
+static vector<StatisticValue> collectStatistics(Scheduler& scheduler) {
+    const OnlineStatistics& statistics = scheduler.getStatistics();
+    double count = scheduler.getProcessCount() > 0 ? scheduler.getProcessCount() : 1;
+    vector<StatisticValue> values = {
+        integerStatistic("processes", scheduler.getProcessCount()),
+        integerStatistic("completed", statistics.completed()),
+        realStatistic("average_waiting", statistics.totalWaiting() / count),
+        realStatistic("average_turnaround", statistics.totalTurnaround() / count),
+        realStatistic("average_response", statistics.totalResponse() / count)
+    };
+    static const char* names[3][4] = {
+        { "waiting_p50", "waiting_p90", "waiting_p99", "waiting_max" },
+        { "turnaround_p50", "turnaround_p90", "turnaround_p99", "turnaround_max" },
+        { "response_p50", "response_p90", "response_p99", "response_max" }
+    };
+    const LatencyHistogram* histograms[3] = {
+        &statistics.waiting(), &statistics.turnaround(), &statistics.response()
+    };
+    for (int i = 0; i < 3; i++) {
+        values.push_back(integerStatistic(names[i][0], histograms[i]->percentile(0.50)));
+        values.push_back(integerStatistic(names[i][1], histograms[i]->percentile(0.90)));
+        values.push_back(integerStatistic(names[i][2], histograms[i]->percentile(0.99)));
+        values.push_back(integerStatistic(names[i][3], histograms[i]->max()));
+    }
+    values.push_back(integerStatistic("makespan", statistics.makespan()));
+    values.push_back(integerStatistic("cpus", scheduler.getCpuCount()));
+    values.push_back(realStatistic("throughput", statistics.throughput()));
+    values.push_back(realStatistic("cpu_utilization", statistics.utilization(scheduler.getCpuCount())));
+    values.push_back(integerStatistic("context_switches", statistics.contextSwitches()));
+    values.push_back(realStatistic("fairness", statistics.fairness()));
+    return values;
+}
+
+bool exportResultsCSV(const string& path, const vector<Process*>& processes, string& error) {
+    ExportFile file;
+    if (!file.open(path, "results", error)) {
+        return false;
+    }
+
+    file.text("pid,arrival,burst,priority,start,completion,waiting,turnaround,blocked,response\n");
+    for (const Process* p : processes) {
+        int row[9] = {
+            p->processID, p->arrivalTime, p->burstTime, p->priority,
+            p->startTime, p->completionTime, p->waitingTime, p->turnaroundTime,
+            p->isBlocked ? 1 : 0
+        };
+        file.integers(row, 9);
+        file.character(',');
+        if (p->hasStarted) {
+            file.integer(p->startTime - p->arrivalTime);
+        }
+        file.character('\n');
+    }
+    return file.close("results", error);
+}
+
+bool exportGanttCSV(const string& path, const vector<GanttEntry>& entries, string& error) {
+    ExportFile file;
+    if (!file.open(path, "Gantt", error)) {
+        return false;
+    }
+
+    file.text("cpu,pid,start,end\n");
+    for (const GanttEntry& entry : entries) {
+        int row[4] = { entry.cpu, entry.processID, entry.startTime, entry.endTime };
+        file.integers(row, 4);
+        file.character('\n');
+    }
+    return file.close("Gantt", error);
+}
+
+bool exportStatisticsCSV(const string& path, Scheduler& scheduler, string& error) {
+    ExportFile file;
+    if (!file.open(path, "statistics", error)) {
+        return false;
+    }
+
+    file.text("metric,value\n");
+    for (const StatisticValue& statistic : collectStatistics(scheduler)) {
+        file.text(statistic.name);
+        file.character(',');
+        writeStatistic(file, statistic);
+        file.character('\n');
+    }
+    return file.close("statistics", error);
+}
+
+bool exportBankerCSV(const string& path, const BankerSnapshot& state, string& error) {
+    ExportFile file;
+    if (!file.open(path, "Banker", error)) {
+        return false;
+    }
+
+    int numResources = state.total.size();
+    file.text("kind,pid,status,safe_order");
+    for (int r = 1; r <= numResources; r++) {
+        file.text(",R");
+        file.integer(r);
+    }
+    file.character('\n');
+
+    file.text("total,,,,");
+    file.integers(state.total.data(), numResources);
+    file.text("\navailable,,,,");
+    file.integers(state.available.data(), numResources);
+    file.character('\n');
+
+    unordered_map<int, int> safeOrder;
+    for (size_t i = 0; i < state.safeSequence.size(); i++) {
+        safeOrder[state.safeSequence[i]] = i;
+    }
+    static const char* kinds[3] = { "max,", "allocation,", "need," };
+    const vector<int>* matrices[3] = { &state.maxMatrix, &state.allocationMatrix, &state.needMatrix };
+    for (size_t slot = 0; slot < state.processIDs.size(); slot++) {
+        int pid = state.processIDs[slot];
+        auto position = safeOrder.find(pid);
+        for (int k = 0; k < 3; k++) {
+            file.text(kinds[k]);
+            file.integer(pid);
+            file.text(state.blocked[slot] ? ",BLOCKED," : ",READY,");
+            if (position != safeOrder.end()) {
+                file.integer(position->second);
+            }
+            file.character(',');
+            file.integers(matrices[k]->data() + slot * numResources, numResources);
+            file.character('\n');
+        }
+    }
+    return file.close("Banker", error);
+}
+
+bool exportResultsJSON(const string& path, Scheduler& scheduler, BankersAlgorithm& banker,
+                       string& error) {
+    ExportFile file;
+    if (!file.open(path, "results", error)) {
+        return false;
+    }
+
+    const vector<Process*>& processes = scheduler.getProcesses();
+    file.text("{\n  \"processes\": [");
+    for (size_t i = 0; i < processes.size(); i++) {
+        const Process* p = processes[i];
+        file.text(i > 0 ? ",\n    {\"pid\": " : "\n    {\"pid\": ");
+        file.integer(p->processID);
+        file.text(", \"arrival\": ");
+        file.integer(p->arrivalTime);
+        file.text(", \"burst\": ");
+        file.integer(p->burstTime);
+        file.text(", \"priority\": ");
+        file.integer(p->priority);
+        file.text(", \"resources\": ");
+        file.jsonArray(p->resourceRequirements.data(), p->resourceRequirements.size());
+        file.text(", \"blocked\": ");
+        file.text(p->isBlocked ? "true" : "false");
+        if (p->hasStarted) {
+            file.text(", \"start\": ");
+            file.integer(p->startTime);
+            file.text(", \"response\": ");
+            file.integer(p->startTime - p->arrivalTime);
+        }
+        if (p->hasStarted && p->remainingTime == 0) {
+            file.text(", \"completion\": ");
+            file.integer(p->completionTime);
+            file.text(", \"waiting\": ");
+            file.integer(p->waitingTime);
+            file.text(", \"turnaround\": ");
+            file.integer(p->turnaroundTime);
+        }
+        file.character('}');
+    }
+    file.text("\n  ],\n");
+
+    // A streamed chart is only counted here; its entries are in the sink
+    const vector<GanttEntry>& gantt = scheduler.getGanttChart();
+    file.text("  \"gantt_entries\": ");
+    file.integer(scheduler.getGanttEntryCount());
+    file.text(",\n  \"gantt\": [");
+    for (size_t i = 0; i < gantt.size(); i++) {
+        file.text(i > 0 ? ",\n    {\"cpu\": " : "\n    {\"cpu\": ");
+        file.integer(gantt[i].cpu);
+        file.text(", \"pid\": ");
+        file.integer(gantt[i].processID);
+        file.text(", \"start\": ");
+        file.integer(gantt[i].startTime);
+        file.text(", \"end\": ");
+        file.integer(gantt[i].endTime);
+        file.character('}');
+    }
+    file.text(gantt.empty() ? "],\n" : "\n  ],\n");
+
+    file.text("  \"statistics\": {");
+    vector<StatisticValue> statistics = collectStatistics(scheduler);
+    for (size_t i = 0; i < statistics.size(); i++) {
+        file.text(i > 0 ? ",\n    \"" : "\n    \"");
+        file.text(statistics[i].name);
+        file.text("\": ");
+        writeStatistic(file, statistics[i]);
+    }
+    file.text("\n  },\n");
+
+    BankerSnapshot state = banker.snapshot();
+    int numResources = state.total.size();
+    file.text("  \"banker\": {\n    \"total\": ");
+    file.jsonArray(state.total.data(), numResources);
+    file.text(",\n    \"available\": ");
+    file.jsonArray(state.available.data(), numResources);
+    file.text(",\n    \"safe_sequence\": ");
+    file.jsonArray(state.safeSequence.data(), state.safeSequence.size());
+    file.text(",\n    \"blocked\": ");
+    file.jsonArray(state.blockedProcesses.data(), state.blockedProcesses.size());
+    file.text(",\n    \"processes\": [");
+    for (size_t slot = 0; slot < state.processIDs.size(); slot++) {
+        file.text(slot > 0 ? ",\n      {\"pid\": " : "\n      {\"pid\": ");
+        file.integer(state.processIDs[slot]);
+        file.text(", \"max\": ");
+        file.jsonArray(state.maxMatrix.data() + slot * numResources, numResources);
+        file.text(", \"allocation\": ");
+        file.jsonArray(state.allocationMatrix.data() + slot * numResources, numResources);
+        file.text(", \"need\": ");
+        file.jsonArray(state.needMatrix.data() + slot * numResources, numResources);
+        file.text(", \"blocked\": ");
+        file.text(state.blocked[slot] ? "true" : "false");
+        file.character('}');
+    }
+    file.text(state.processIDs.empty() ? "]\n  }\n}\n" : "\n    ]\n  }\n}\n");
+    return file.close("results", error);
+}
+
+// "out/run.csv" -> "out/run_gantt.csv"
+static string siblingPath(const string& path, const char* suffix) {
+    size_t slash = path.find_last_of('/');
+    size_t dot = path.find_last_of('.');
+    if (dot == string::npos || (slash != string::npos && dot < slash)) {
+        return path + suffix + ".csv";
+    }
+    return path.substr(0, dot) + suffix + path.substr(dot);
+}
+
+bool exportResults(const string& path, Scheduler& scheduler, BankersAlgorithm& banker,
+                   vector<string>& files, string& error) {
+    files.clear();
+    if (path.size() >= 5 && path.compare(path.size() - 5, 5, ".json") == 0) {
+        if (!exportResultsJSON(path, scheduler, banker, error)) return false;
+        files.push_back(path);
+        return true;
+    }
+
+    if (!exportResultsCSV(path, scheduler.getProcesses(), error)) return false;
+    files.push_back(path);
+
+    const vector<GanttEntry>& gantt = scheduler.getGanttChart();
+    if ((long)gantt.size() == scheduler.getGanttEntryCount()) {
+        string ganttPath = siblingPath(path, "_gantt");
+        if (!exportGanttCSV(ganttPath, gantt, error)) return false;
+        files.push_back(ganttPath);
+    }
+
+    string statisticsPath = siblingPath(path, "_stats");
+    if (!exportStatisticsCSV(statisticsPath, scheduler, error)) return false;
+    files.push_back(statisticsPath);
+
+    string bankerPath = siblingPath(path, "_banker");
+    if (!exportBankerCSV(bankerPath, banker.snapshot(), error)) return false;
+    files.push_back(bankerPath);
+    return true;
+}
@@ -0,0 +1,41 @@
+#ifndef RESULT_EXPORT_H
+#define RESULT_EXPORT_H
+
+#include <string>
+#include <vector>
+#include "Process.h"
+#include "Scheduler.h"
+#include "BankersAlgorithm.h"
+
+// Write one CSV row per process with its scheduling results:
+//   pid,arrival,burst,priority,start,completion,waiting,turnaround,blocked,response
+// response is empty for processes that never ran.
+bool exportResultsCSV(const std::string& path, const std::vector<Process*>& processes,
+                      std::string& error);
+
+// Gantt entries as cpu,pid,start,end (the --gantt format)
+bool exportGanttCSV(const std::string& path, const std::vector<GanttEntry>& entries,
+                    std::string& error);
+
+// One metric,value row per figure of displayStatistics
+bool exportStatisticsCSV(const std::string& path, Scheduler& scheduler, std::string& error);
+
+// One row per resource vector: kind,pid,status,safe_order,R1,...,Rm with
+// kind total or available (other columns empty), then max, allocation and
+// need for every process. safe_order is the process's position in the safe
+// sequence, empty if it is not in it.
+bool exportBankerCSV(const std::string& path, const BankerSnapshot& state, std::string& error);
+
+// Everything above as one JSON document with processes, gantt, statistics
+// and banker members
+bool exportResultsJSON(const std::string& path, Scheduler& scheduler, BankersAlgorithm& banker,
+                       std::string& error);
+
+// A path ending in .json gets exportResultsJSON. Anything else gets the
+// process CSV, with the Gantt chart, statistics and Banker state next to it
+// as NAME_gantt.csv, NAME_stats.csv and NAME_banker.csv. A Gantt chart that
+// was streamed to a sink is not written again. files lists what was written.
+bool exportResults(const std::string& path, Scheduler& scheduler, BankersAlgorithm& banker,
+                   std::vector<std::string>& files, std::string& error);
+
+#endif
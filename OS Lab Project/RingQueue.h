@@ -0,0 +1,38 @@
+#ifndef RING_QUEUE_H
+#define RING_QUEUE_H
+
+#include <vector>
+
+// Fixed-capacity FIFO of process indices backed by a ring buffer.
+// push/pop are O(1) and never allocate after construction.
+class RingQueue {
+private:
+    std::vector<int> slots;
+    int head;
+    int count;
+
+public:
+    RingQueue(int capacity = 0) : slots(capacity > 0 ? capacity : 1), head(0), count(0) {}
+
+    void push(int value) {
+        int tail = head + count;
+        if (tail >= (int)slots.size()) tail -= slots.size();
+        slots[tail] = value;
+        count++;
+    }
+
+    int pop() {
+        int value = slots[head];
+        if (++head == (int)slots.size()) head = 0;
+        count--;
+        return value;
+    }
+
+    int front() const { return slots[head]; }
+    bool empty() const { return count == 0; }
+    int size() const { return count; }
+    int capacity() const { return slots.size(); }
+    void clear() { head = 0; count = 0; }
+};
+
+#endif
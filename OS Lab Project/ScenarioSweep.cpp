@@ -0,0 +1,164 @@
+#include "ScenarioSweep.h"
+#include <pthread.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include "Scheduler.h"
+#include "BankersAlgorithm.h"
+
+using namespace std;
+
+// One scenario and what came out of it
+struct SweepTask {
+    const SimulationConfig* config;
+    double averageWaiting;
+    double averageTurnaround;
+    int makespan;
+    int blocked;
+    double elapsedMs;
+};
+
+struct SweepPool {
+    const vector<Process*>* workload;
+    vector<SweepTask>* tasks;
+    atomic<size_t> next;
+};
+
+static void runScenario(const vector<Process*>& workload, SweepTask& task) {
+    const SimulationConfig& config = *task.config;
+    auto start = chrono::steady_clock::now();
+    
+    BankersAlgorithm banker(config.totalResources.size(), config.totalResources);
+    Scheduler scheduler;
+    configureScheduler(scheduler, config);
+    ostream silent(nullptr);
+    scheduler.setOutput(&silent);
+    
+    // Only the statistics are reported, so slices are dropped as they close
+    GanttCallbackSink discard([](const GanttEntry&) {});
+    scheduler.setGanttSink(&discard);
+    
+    vector<Process*> copies;
+    copies.reserve(workload.size());
+    for (const Process* p : workload) {
+        copies.push_back(new Process(*p));
+    }
+    scheduler.addProcesses(copies);
+    scheduler.setBanker(&banker);
+    scheduler.executeScheduling();
+    
+    const OnlineStatistics& statistics = scheduler.getStatistics();
+    task.makespan = 0;
+    task.blocked = 0;
+    for (const Process* p : scheduler.getProcesses()) {
+        task.makespan = max(task.makespan, p->completionTime);
+        if (p->isBlocked) task.blocked++;
+    }
+    size_t count = max<size_t>(copies.size(), 1);
+    task.averageWaiting = statistics.totalWaiting() / count;
+    task.averageTurnaround = statistics.totalTurnaround() / count;
+    task.elapsedMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+static void* sweepWorker(void* arg) {
+    SweepPool* pool = (SweepPool*)arg;
+    size_t i;
+    while ((i = pool->next.fetch_add(1)) < pool->tasks->size()) {
+        runScenario(*pool->workload, (*pool->tasks)[i]);
+    }
+    return NULL;
+}
+
+bool runScenarioSweep(const SimulationConfig& base, const vector<Process*>& workload,
+                      string& error) {
+    vector<SimulationConfig> scenarios;
+    vector<string> labels;
+    if (!expandSweep(base, scenarios, labels, error)) {
+        return false;
+    }
+    
+    // Every scenario must be able to grant each process its full requirement
+    vector<int> peak(base.totalResources.size(), 0);
+    for (const Process* p : workload) {
+        for (size_t r = 0; r < peak.size() && r < p->resourceRequirements.size(); r++) {
+            peak[r] = max(peak[r], p->resourceRequirements[r]);
+        }
+    }
+    for (size_t i = 0; i < scenarios.size(); i++) {
+        for (size_t r = 0; r < peak.size(); r++) {
+            if (peak[r] > scenarios[i].totalResources[r]) {
+                error = "--sweep " + labels[i] + ": a process needs " + to_string(peak[r]) +
+                        " of R" + to_string(r + 1) + ", more than its total of " +
+                        to_string(scenarios[i].totalResources[r]);
+                return false;
+            }
+        }
+    }
+    
+    int numThreads = base.sweepThreads;
+    if (numThreads <= 0) {
+        numThreads = max(1L, sysconf(_SC_NPROCESSORS_ONLN));
+    }
+    numThreads = min<int>(numThreads, scenarios.size());
+    
+    cout << "\n========================================" << endl;
+    cout << "SCENARIO SWEEP" << endl;
+    cout << "========================================" << endl;
+    cout << "Scenarios: " << scenarios.size() << ", Threads: " << numThreads
+         << ", Processes: " << workload.size() << endl;
+    
+    vector<SweepTask> tasks(scenarios.size());
+    for (size_t i = 0; i < scenarios.size(); i++) {
+        tasks[i].config = &scenarios[i];
+    }
+    SweepPool pool;
+    pool.workload = &workload;
+    pool.tasks = &tasks;
+    pool.next = 0;
+    
+    auto start = chrono::steady_clock::now();
+    vector<pthread_t> threads(numThreads);
+    for (int i = 0; i < numThreads; i++) {
+        pthread_create(&threads[i], NULL, sweepWorker, &pool);
+    }
+    for (int i = 0; i < numThreads; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    double wallMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    
+    size_t labelWidth = 10;
+    for (const string& label : labels) {
+        labelWidth = max(labelWidth, label.size() + 2);
+    }
+    
+    cout << "\n========================================" << endl;
+    cout << "          SWEEP RESULTS" << endl;
+    cout << "========================================" << endl;
+    cout << left << setw(labelWidth) << "Scenario"
+         << setw(12) << "Avg Wait"
+         << setw(12) << "Avg TAT"
+         << setw(11) << "Makespan"
+         << setw(9) << "Blocked"
+         << "Time (ms)" << endl;
+    cout << "----------------------------------------" << endl;
+    
+    double busyMs = 0;
+    cout << fixed << setprecision(2);
+    for (size_t i = 0; i < tasks.size(); i++) {
+        const SweepTask& task = tasks[i];
+        cout << left << setw(labelWidth) << labels[i]
+             << setw(12) << task.averageWaiting
+             << setw(12) << task.averageTurnaround
+             << setw(11) << task.makespan
+             << setw(9) << task.blocked
+             << setprecision(1) << task.elapsedMs << setprecision(2) << endl;
+        busyMs += task.elapsedMs;
+    }
+    cout << setprecision(1);
+    cout << "\nWall time: " << wallMs << " ms (" << busyMs << " ms of scenario time)" << endl;
+    cout << "========================================\n" << endl;
+    return true;
+}
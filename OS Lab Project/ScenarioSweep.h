@@ -0,0 +1,16 @@
+#ifndef SCENARIO_SWEEP_H
+#define SCENARIO_SWEEP_H
+
+#include <string>
+#include <vector>
+#include "Process.h"
+#include "SimulationConfig.h"
+
+// Schedule a private copy of workload under every combination of
+// base.sweep, one scenario per task on a pool of threads, and print a
+// comparison table. Each scenario owns its Scheduler and BankersAlgorithm;
+// the workload itself is only read.
+bool runScenarioSweep(const SimulationConfig& base, const std::vector<Process*>& workload,
+                      std::string& error);
+
+#endif
@@ -3,11 +3,21 @@
 #include <iomanip>
 #include <algorithm>
 #include <queue>
+#include <deque>
+#include <set>
+#include <cstring>
 #include <climits>
+#include <unordered_map>
+#include "RingQueue.h"
+#include "IndexedHeap.h"
+#include "Logger.h"
 
 using namespace std;
 
-Scheduler::Scheduler() : timeQuantum(2), banker(nullptr) {}
+Scheduler::Scheduler() : ganttSink(nullptr), ganttEntries(0), timeQuantum(2), agingInterval(0),
+                         policy(POLICY_AUTO), mlfqBoostPeriod(100), predictorAlpha(0), predictorInitial(5),
+                         banker(nullptr), numCpus(1), steals(0), migrations(0), makespan(0),
+                         out(&cout) {}
 
 Scheduler::~Scheduler() {
     for (auto p : processes) {
@@ -22,14 +32,135 @@ void Scheduler::addProcess(Process* process) {
     }
 }
 
+void Scheduler::addProcesses(const vector<Process*>& list) {
+    processes.insert(processes.end(), list.begin(), list.end());
+    if (banker && !list.empty()) {
+        banker->addProcesses(list.data(), list.size());
+    }
+}
+
 void Scheduler::setBanker(BankersAlgorithm* bankerAlgo) {
     banker = bankerAlgo;
+    
+    // Processes added before the Banker was attached are registered now
+    if (banker && !processes.empty()) {
+        banker->addProcesses(processes.data(), processes.size());
+    }
+}
+
+// Ties in both algorithms go to the earlier process in the list, so putting
+// the list in a fixed order makes a run independent of consumption order
+void Scheduler::sortProcessesByID() {
+    stable_sort(processes.begin(), processes.end(), [](const Process* a, const Process* b) {
+        return a->processID < b->processID;
+    });
 }
 
 void Scheduler::setTimeQuantum(int quantum) {
     timeQuantum = quantum;
 }
 
+void Scheduler::setAgingInterval(int interval) {
+    agingInterval = interval > 0 ? interval : 0;
+}
+
+void Scheduler::setPolicy(SchedulingPolicy schedulingPolicy) {
+    policy = schedulingPolicy;
+}
+
+void Scheduler::setMlfqLevels(const vector<int>& quanta, int boostPeriod) {
+    mlfqQuanta = quanta;
+    mlfqBoostPeriod = boostPeriod > 0 ? boostPeriod : 0;
+}
+
+void Scheduler::setBurstPredictor(double alpha, double initialGuess) {
+    predictorAlpha = (alpha > 0 && alpha <= 1) ? alpha : 0;
+    predictorInitial = initialGuess > 0 ? initialGuess : 1;
+}
+
+void Scheduler::setOutput(ostream* stream) {
+    out = stream;
+}
+
+void Scheduler::setGanttSink(GanttSink* sink) {
+    ganttSink = sink;
+}
+
+void Scheduler::setCpuCount(int cpus) {
+    numCpus = cpus > 1 ? cpus : 1;
+}
+
+bool Scheduler::parsePolicy(const char* name, SchedulingPolicy& schedulingPolicy) {
+    static const struct { const char* name; SchedulingPolicy policy; } names[] = {
+        { "auto", POLICY_AUTO },
+        { "priority", POLICY_PRIORITY },
+        { "rr", POLICY_ROUND_ROBIN },
+        { "preemptive-priority", POLICY_PREEMPTIVE_PRIORITY },
+        { "mlfq", POLICY_MLFQ },
+        { "sjf", POLICY_SJF },
+        { "srtf", POLICY_SRTF }
+    };
+    for (const auto& entry : names) {
+        if (strcmp(name, entry.name) == 0) {
+            schedulingPolicy = entry.policy;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Record a run of p on cpu. The CPU's latest slice stays open until the next
+// one: with a sink attached, the same process continuing without a gap
+// extends it; the in-memory chart keeps every slice as recorded. Returns
+// false if p continues its latest slice on this CPU.
+bool Scheduler::recordSlice(Process* p, int start, int end, int cpu) {
+    GanttEntry& open = openSlices[cpu];
+    bool continues = open.cpu >= 0 && openProcesses[cpu] == p && open.endTime == start && start != end;
+    statistics.addSlice(end - start, open.cpu >= 0 && openProcesses[cpu] != p);
+    if (continues && ganttSink) {
+        open.endTime = end;
+        return false;
+    }
+    if (open.cpu >= 0) {
+        emitSlice(open);
+    }
+    open.processID = p->processID;
+    open.startTime = start;
+    open.endTime = end;
+    open.cpu = cpu;
+    openProcesses[cpu] = p;
+    return !continues;
+}
+
+void Scheduler::emitSlice(const GanttEntry& entry) {
+    ganttEntries++;
+    if (ganttSink) {
+        ganttSink->write(entry);
+    } else {
+        ganttChart.push_back(entry);
+    }
+}
+
+// Close every CPU's open slice once the run is over
+void Scheduler::closeSlices() {
+    for (GanttEntry& open : openSlices) {
+        if (open.cpu >= 0) {
+            emitSlice(open);
+            open.cpu = -1;
+        }
+    }
+    if (ganttSink) {
+        ganttSink->flush();
+    }
+}
+
+void Scheduler::finishProcess(Process* p, int time) {
+    p->completionTime = time;
+    p->turnaroundTime = p->completionTime - p->arrivalTime;
+    p->waitingTime = p->turnaroundTime - p->burstTime;
+    statistics.add(*p);
+}
+
 int Scheduler::getProcessCount() {
     return processes.size();
 }
@@ -38,39 +169,70 @@ vector<Process*>& Scheduler::getProcesses() {
     return processes;
 }
 
-vector<int> Scheduler::getReadyProcesses(int currentTime, vector<bool>& completed) {
-    vector<int> readyQueue;
-    for (int i = 0; i < processes.size(); i++) {
-        if (!completed[i] && processes[i]->arrivalTime <= currentTime && 
-            processes[i]->remainingTime > 0 && !processes[i]->isBlocked) {
-            readyQueue.push_back(i);
+// Indices of all processes sorted by arrival time; ties keep insertion
+// order. blockedCount is set to the number already blocked.
+vector<int> Scheduler::arrivalOrder(int& blockedCount) const {
+    int n = processes.size();
+    vector<int> arrivals(n);
+    blockedCount = 0;
+    for (int i = 0; i < n; i++) {
+        arrivals[i] = i;
+        if (processes[i]->isBlocked) {
+            blockedCount++;
         }
     }
-    return readyQueue;
+    stable_sort(arrivals.begin(), arrivals.end(), [this](int a, int b) {
+        return processes[a]->arrivalTime < processes[b]->arrivalTime;
+    });
+    return arrivals;
 }
 
 void Scheduler::priorityScheduling() {
-    cout << "\n========================================" << endl;
-    cout << "EXECUTING: PRIORITY SCHEDULING (Non-preemptive)" << endl;
-    cout << "========================================\n" << endl;
+    *out << "\n========================================" << endl;
+    *out << "EXECUTING: PRIORITY SCHEDULING (Non-preemptive)" << endl;
+    *out << "========================================\n" << endl;
     
-    vector<bool> completed(processes.size(), false);
+    int n = processes.size();
+    vector<bool> inReady(n, false);
     int currentTime = 0;
     int completedCount = 0;
-    ganttChart.clear();
     
-    while (completedCount < processes.size()) {
-        vector<int> readyQueue = getReadyProcesses(currentTime, completed);
-        
-        if (readyQueue.empty()) {
-            int nextArrival = INT_MAX;
-            for (size_t i = 0; i < processes.size(); i++) {
-                if (!completed[i] && processes[i]->arrivalTime > currentTime) {
-                    nextArrival = min(nextArrival, processes[i]->arrivalTime);
-                }
+    int blockedCount;
+    vector<int> arrivals = arrivalOrder(blockedCount);
+    size_t nextArrival = 0;
+    
+    // Ready set as a min-heap on (priority, arrivalTime, index). Entries that
+    // leave the ready set are discarded lazily when they reach the top.
+    auto later = [this](int a, int b) {
+        if (processes[a]->priority != processes[b]->priority)
+            return processes[a]->priority > processes[b]->priority;
+        if (processes[a]->arrivalTime != processes[b]->arrivalTime)
+            return processes[a]->arrivalTime > processes[b]->arrivalTime;
+        return a > b;
+    };
+    priority_queue<int, vector<int>, decltype(later)> readyHeap(later);
+    
+    // Same ready set ordered by index, for the Banker fallback scan
+    set<int> readySet;
+    
+    // Processes that are neither completed nor blocked
+    int runnableCount = n - blockedCount;
+    
+    while (completedCount < n) {
+        // Admit everything that has arrived by now
+        while (nextArrival < arrivals.size() &&
+               processes[arrivals[nextArrival]]->arrivalTime <= currentTime) {
+            int idx = arrivals[nextArrival++];
+            if (!processes[idx]->isBlocked && processes[idx]->remainingTime > 0) {
+                readyHeap.push(idx);
+                readySet.insert(idx);
+                inReady[idx] = true;
             }
-            if (nextArrival != INT_MAX) {
-                currentTime = nextArrival;
+        }
+        
+        if (readySet.empty()) {
+            if (nextArrival < arrivals.size()) {
+                currentTime = processes[arrivals[nextArrival]]->arrivalTime;
                 continue;
             } else {
                 // No more processes can arrive, but some are blocked
@@ -79,79 +241,55 @@ void Scheduler::priorityScheduling() {
             }
         }
         
-        int selectedIdx = -1;
-        
-        // Try to find a process that can be allocated resources
-        for (int idx : readyQueue) {
-            // First, try to select by priority
-            if (selectedIdx == -1) {
-                selectedIdx = idx;
-            } else if (processes[idx]->priority < processes[selectedIdx]->priority) {
-                selectedIdx = idx;
-            } else if (processes[idx]->priority == processes[selectedIdx]->priority) {
-                if (processes[idx]->arrivalTime < processes[selectedIdx]->arrivalTime) {
-                    selectedIdx = idx;
-                }
-            }
-        }
-        
-        if (selectedIdx == -1) {
-            break; // No process can be selected
+        while (!inReady[readyHeap.top()]) {
+            readyHeap.pop();
         }
-        
+        int selectedIdx = readyHeap.top();
         Process* p = processes[selectedIdx];
         
         // Check resource allocation with Banker's Algorithm
         if (banker && !banker->requestResources(p)) {
-            cout << "[BLOCKED] Process P" << p->processID 
-                 << " blocked - unsafe state" << endl;
+            LOG_WARN("[BLOCKED] Process P{} blocked - unsafe state", p->processID);
             
             // Mark as blocked and try to find another process
             p->isBlocked = true;
+            readySet.erase(selectedIdx);
+            inReady[selectedIdx] = false;
+            runnableCount--;
             
             // Try to find an unblocked process from ready queue
             bool foundUnblocked = false;
-            for (int idx : readyQueue) {
-                if (idx != selectedIdx && !processes[idx]->isBlocked) {
-                    if (banker->requestResources(processes[idx])) {
-                        selectedIdx = idx;
-                        p = processes[idx];
-                        foundUnblocked = true;
-                        break;
-                    } else {
-                        processes[idx]->isBlocked = true;
-                    }
+            for (auto it = readySet.begin(); it != readySet.end(); ) {
+                int idx = *it;
+                it = readySet.erase(it);
+                inReady[idx] = false;
+                if (banker->requestResources(processes[idx])) {
+                    selectedIdx = idx;
+                    p = processes[idx];
+                    foundUnblocked = true;
+                    break;
+                } else {
+                    processes[idx]->isBlocked = true;
+                    runnableCount--;
                 }
             }
             
             if (!foundUnblocked) {
                 // All ready processes are blocked, advance time or exit
-                cout << "[WARNING] All ready processes blocked. ";
-                
                 // Check if any process can eventually run
-                bool canContinue = false;
-                for (size_t i = 0; i < processes.size(); i++) {
-                    if (!completed[i] && !processes[i]->isBlocked) {
-                        canContinue = true;
-                        break;
-                    }
-                }
-                
-                if (!canContinue) {
-                    cout << "Cannot proceed safely. Skipping blocked processes." << endl;
-                    // Mark all blocked processes as "completed" to exit
-                    for (size_t i = 0; i < processes.size(); i++) {
-                        if (processes[i]->isBlocked && !completed[i]) {
-                            completed[i] = true;
-                            completedCount++;
-                        }
-                    }
+                if (runnableCount == 0) {
+                    LOG_WARN("[WARNING] All ready processes blocked. "
+                             "Cannot proceed safely. Skipping blocked processes.");
                     break;
                 }
+                LOG_WARN("[WARNING] All ready processes blocked.");
                 
                 currentTime++;
                 continue;
             }
+        } else {
+            readySet.erase(selectedIdx);
+            inReady[selectedIdx] = false;
         }
         
         if (!p->hasStarted) {
@@ -159,19 +297,12 @@ void Scheduler::priorityScheduling() {
             p->hasStarted = true;
         }
         
-        GanttEntry entry;
-        entry.processID = p->processID;
-        entry.startTime = currentTime;
+        recordSlice(p, currentTime, currentTime + p->burstTime);
         currentTime += p->burstTime;
-        entry.endTime = currentTime;
-        ganttChart.push_back(entry);
-        
-        p->completionTime = currentTime;
-        p->turnaroundTime = p->completionTime - p->arrivalTime;
-        p->waitingTime = p->turnaroundTime - p->burstTime;
+        finishProcess(p, currentTime);
         p->remainingTime = 0;
-        completed[selectedIdx] = true;
         completedCount++;
+        runnableCount--;
         
         // Release resources
         if (banker) {
@@ -181,81 +312,77 @@ void Scheduler::priorityScheduling() {
 }
 
 void Scheduler::roundRobinScheduling() {
-    cout << "\n========================================" << endl;
-    cout << "EXECUTING: ROUND ROBIN SCHEDULING (Preemptive)" << endl;
-    cout << "Time Quantum: " << timeQuantum << endl;
-    cout << "========================================\n" << endl;
+    *out << "\n========================================" << endl;
+    *out << "EXECUTING: ROUND ROBIN SCHEDULING (Preemptive)" << endl;
+    *out << "Time Quantum: " << timeQuantum << endl;
+    *out << "========================================\n" << endl;
     
-    queue<int> readyQueue;
-    vector<bool> inQueue(processes.size(), false);
-    vector<bool> completed(processes.size(), false);
+    int n = processes.size();
+    RingQueue readyQueue(n);  // Each process is queued at most once
     int currentTime = 0;
     int completedCount = 0;
-    ganttChart.clear();
     int consecutiveBlocks = 0; // Track consecutive blocked attempts
     
-    for (size_t i = 0; i < processes.size(); i++) {
-        if (processes[i]->arrivalTime <= currentTime && !processes[i]->isBlocked) {
-            readyQueue.push(i);
-            inQueue[i] = true;
+    int blockedCount;  // RR checks isBlocked as processes reach the queue
+    vector<int> arrivals = arrivalOrder(blockedCount);
+    size_t nextArrival = 0;
+    
+    // Zero-burst arrivals are only picked up when the queue drains
+    vector<int> deferred;
+    vector<int> batch;
+    
+    // Move arrivals up to currentTime into the ready queue in index order.
+    // A full admission also takes deferred zero-burst processes.
+    auto admitArrivals = [&](bool fullAdmission) {
+        batch.clear();
+        if (fullAdmission) {
+            batch.swap(deferred);
         }
-    }
+        while (nextArrival < arrivals.size() &&
+               processes[arrivals[nextArrival]]->arrivalTime <= currentTime) {
+            batch.push_back(arrivals[nextArrival++]);
+        }
+        sort(batch.begin(), batch.end());
+        for (int idx : batch) {
+            if (processes[idx]->isBlocked) {
+                continue;
+            }
+            if (fullAdmission || processes[idx]->remainingTime > 0) {
+                readyQueue.push(idx);
+            } else {
+                deferred.push_back(idx);
+            }
+        }
+    };
+    
+    admitArrivals(true);
     
-    while (completedCount < processes.size()) {
+    while (completedCount < n) {
         if (readyQueue.empty()) {
-            int nextArrival = INT_MAX;
-            for (size_t i = 0; i < processes.size(); i++) {
-                if (!completed[i] && processes[i]->arrivalTime > currentTime) {
-                    nextArrival = min(nextArrival, processes[i]->arrivalTime);
-                }
-            }
-            if (nextArrival != INT_MAX) {
-                currentTime = nextArrival;
-                for (size_t i = 0; i < processes.size(); i++) {
-                    if (!inQueue[i] && !completed[i] && 
-                        processes[i]->arrivalTime <= currentTime && 
-                        !processes[i]->isBlocked) {
-                        readyQueue.push(i);
-                        inQueue[i] = true;
-                    }
-                }
+            if (nextArrival < arrivals.size()) {
+                currentTime = processes[arrivals[nextArrival]]->arrivalTime;
+                admitArrivals(true);
                 consecutiveBlocks = 0;
             } else {
                 // No more arrivals and queue empty - all remaining must be blocked
-                cout << "[WARNING] All remaining processes blocked. Terminating." << endl;
-                for (size_t i = 0; i < processes.size(); i++) {
-                    if (!completed[i]) {
-                        completed[i] = true;
-                        completedCount++;
-                    }
-                }
+                LOG_WARN("[WARNING] All remaining processes blocked. Terminating.");
                 break;
             }
             continue;
         }
         
         // Check if we're in an infinite loop (all processes blocked)
-        if (consecutiveBlocks > processes.size()) {
-            cout << "[WARNING] Deadlock detected - all processes blocked. Terminating." << endl;
-            for (size_t i = 0; i < processes.size(); i++) {
-                if (!completed[i]) {
-                    completed[i] = true;
-                    completedCount++;
-                }
-            }
+        if (consecutiveBlocks > n) {
+            LOG_WARN("[WARNING] Deadlock detected - all processes blocked. Terminating.");
             break;
         }
         
-        int idx = readyQueue.front();
-        readyQueue.pop();
-        inQueue[idx] = false;
-        
+        int idx = readyQueue.pop();
         Process* p = processes[idx];
         
         // Check resources with Banker's Algorithm
         if (banker && !p->hasStarted && !banker->requestResources(p)) {
-            cout << "[BLOCKED] Process P" << p->processID 
-                 << " blocked - unsafe state" << endl;
+            LOG_WARN("[BLOCKED] Process P{} blocked - unsafe state", p->processID);
             p->isBlocked = true;
             consecutiveBlocks++;
             
@@ -272,30 +399,15 @@ void Scheduler::roundRobinScheduling() {
         
         int executionTime = min(timeQuantum, p->remainingTime);
         
-        GanttEntry entry;
-        entry.processID = p->processID;
-        entry.startTime = currentTime;
+        recordSlice(p, currentTime, currentTime + executionTime);
         currentTime += executionTime;
-        entry.endTime = currentTime;
-        ganttChart.push_back(entry);
         
         p->remainingTime -= executionTime;
         
-        for (size_t i = 0; i < processes.size(); i++) {
-            if (!inQueue[i] && !completed[i] && i != idx &&
-                processes[i]->arrivalTime <= currentTime && 
-                processes[i]->remainingTime > 0 &&
-                !processes[i]->isBlocked) {
-                readyQueue.push(i);
-                inQueue[i] = true;
-            }
-        }
+        admitArrivals(false);
         
         if (p->remainingTime == 0) {
-            p->completionTime = currentTime;
-            p->turnaroundTime = p->completionTime - p->arrivalTime;
-            p->waitingTime = p->turnaroundTime - p->burstTime;
-            completed[idx] = true;
+            finishProcess(p, currentTime);
             completedCount++;
             
             // Release resources
@@ -304,11 +416,549 @@ void Scheduler::roundRobinScheduling() {
             }
         } else {
             readyQueue.push(idx);
-            inQueue[idx] = true;
         }
     }
 }
 
+void Scheduler::preemptivePriorityScheduling() {
+    *out << "\n========================================" << endl;
+    *out << "EXECUTING: PRIORITY SCHEDULING (Preemptive)" << endl;
+    if (agingInterval > 0) {
+        *out << "Aging: one priority level per " << agingInterval << " time units waiting" << endl;
+    }
+    *out << "========================================\n" << endl;
+    
+    int n = processes.size();
+    int currentTime = 0;
+    int finishedCount = 0;  // Completed or blocked
+    
+    // Effective priority; aging lowers it (towards 1) while a process waits
+    vector<int> effective(n);
+    
+    vector<int> arrivals = arrivalOrder(finishedCount);
+    size_t nextArrival = 0;
+    
+    auto better = [this, &effective](int a, int b) {
+        if (effective[a] != effective[b])
+            return effective[a] < effective[b];
+        if (processes[a]->arrivalTime != processes[b]->arrivalTime)
+            return processes[a]->arrivalTime < processes[b]->arrivalTime;
+        return a < b;
+    };
+    IndexedHeap<decltype(better)> readyHeap(n, better);
+    
+    // Pending boosts as (time, index, stamp); a stamp that no longer matches
+    // the process's means it left the ready set since the event was queued
+    typedef pair<int, pair<int, int> > AgingEvent;
+    priority_queue<AgingEvent, vector<AgingEvent>, greater<AgingEvent> > agingEvents;
+    vector<int> readyStamp(n, 0);
+    
+    auto makeReady = [&](int idx) {
+        readyHeap.push(idx);
+        readyStamp[idx]++;
+        if (agingInterval > 0 && effective[idx] > 1) {
+            agingEvents.push(AgingEvent(currentTime + agingInterval, make_pair(idx, readyStamp[idx])));
+        }
+    };
+    
+    for (int i = 0; i < n; i++) {
+        effective[i] = processes[i]->priority;
+    }
+    
+    int running = -1;
+    int sliceStart = 0;
+    
+    while (finishedCount < n) {
+        // Admit everything that has arrived by now
+        while (nextArrival < arrivals.size() &&
+               processes[arrivals[nextArrival]]->arrivalTime <= currentTime) {
+            int idx = arrivals[nextArrival++];
+            if (!processes[idx]->isBlocked) {
+                makeReady(idx);
+            }
+        }
+        
+        // Apply due boosts with decrease-key
+        while (!agingEvents.empty() && agingEvents.top().first <= currentTime) {
+            AgingEvent event = agingEvents.top();
+            agingEvents.pop();
+            int idx = event.second.first;
+            if (event.second.second != readyStamp[idx] || !readyHeap.contains(idx)) {
+                continue;
+            }
+            effective[idx]--;
+            readyHeap.update(idx);
+            if (effective[idx] > 1) {
+                agingEvents.push(AgingEvent(event.first + agingInterval, event.second));
+            }
+        }
+        
+        // Preempt if a strictly more urgent process is waiting
+        if (running >= 0 && !readyHeap.empty() &&
+            effective[readyHeap.top()] < effective[running]) {
+            recordSlice(processes[running], sliceStart, currentTime);
+            makeReady(running);
+            running = -1;
+        }
+        
+        if (running < 0) {
+            while (!readyHeap.empty()) {
+                int idx = readyHeap.pop();
+                Process* p = processes[idx];
+                
+                // Resources are claimed on first dispatch and held until completion
+                if (banker && !p->hasStarted && !banker->requestResources(p)) {
+                    LOG_WARN("[BLOCKED] Process P{} blocked - unsafe state", p->processID);
+                    p->isBlocked = true;
+                    finishedCount++;
+                    continue;
+                }
+                running = idx;
+                break;
+            }
+            
+            if (running < 0) {
+                if (nextArrival < arrivals.size()) {
+                    currentTime = max(currentTime, processes[arrivals[nextArrival]]->arrivalTime);
+                    continue;
+                }
+                if (finishedCount < n) {
+                    LOG_WARN("[WARNING] All remaining processes blocked. Terminating.");
+                }
+                break;
+            }
+            
+            Process* p = processes[running];
+            if (!p->hasStarted) {
+                p->startTime = currentTime;
+                p->hasStarted = true;
+            }
+            sliceStart = currentTime;
+        }
+        
+        // Run until completion or the next event that could preempt
+        Process* p = processes[running];
+        int nextEvent = currentTime + p->remainingTime;
+        if (nextArrival < arrivals.size()) {
+            nextEvent = min(nextEvent, processes[arrivals[nextArrival]]->arrivalTime);
+        }
+        if (!agingEvents.empty()) {
+            nextEvent = min(nextEvent, agingEvents.top().first);
+        }
+        nextEvent = max(nextEvent, currentTime);
+        p->remainingTime -= nextEvent - currentTime;
+        currentTime = nextEvent;
+        
+        if (p->remainingTime == 0) {
+            recordSlice(p, sliceStart, currentTime);
+            finishProcess(p, currentTime);
+            finishedCount++;
+            running = -1;
+            
+            // Release resources
+            if (banker) {
+                banker->releaseResources(p);
+            }
+        }
+    }
+}
+
+void Scheduler::mlfqScheduling() {
+    // Default: three levels at 1x, 2x and 4x the Round Robin quantum
+    vector<int> quanta = mlfqQuanta;
+    if (quanta.empty()) {
+        int base = max(timeQuantum, 1);
+        quanta = { base, 2 * base, 4 * base };
+    }
+    int levels = quanta.size();
+    
+    *out << "\n========================================" << endl;
+    *out << "EXECUTING: MULTILEVEL FEEDBACK QUEUE (Preemptive)" << endl;
+    *out << "Levels: " << levels << ", quanta:";
+    for (int q : quanta) *out << " " << q;
+    *out << endl;
+    if (mlfqBoostPeriod > 0) {
+        *out << "Priority boost every " << mlfqBoostPeriod << " time units" << endl;
+    }
+    *out << "========================================\n" << endl;
+    
+    int n = processes.size();
+    int currentTime = 0;
+    int finishedCount = 0;  // Completed or blocked
+    
+    vector<RingQueue> queues(levels, RingQueue(n));  // Each process is queued at most once
+    vector<int> level(n, 0);
+    vector<int> used(n, 0);  // Time used against the current level's allotment
+    
+    vector<int> arrivals = arrivalOrder(finishedCount);
+    size_t nextArrival = 0;
+    int nextBoost = mlfqBoostPeriod > 0 ? mlfqBoostPeriod : INT_MAX;
+    
+    while (finishedCount < n) {
+        // New arrivals enter the top level
+        while (nextArrival < arrivals.size() &&
+               processes[arrivals[nextArrival]]->arrivalTime <= currentTime) {
+            int idx = arrivals[nextArrival++];
+            if (!processes[idx]->isBlocked) {
+                level[idx] = 0;
+                used[idx] = 0;
+                queues[0].push(idx);
+            }
+        }
+        
+        // Periodic boost: everything back to the top with a fresh allotment
+        if (currentTime >= nextBoost) {
+            for (int l = 0; l < levels; l++) {
+                for (int k = queues[l].size(); k > 0; k--) {
+                    int idx = queues[l].pop();
+                    level[idx] = 0;
+                    used[idx] = 0;
+                    queues[0].push(idx);
+                }
+            }
+            while (nextBoost <= currentTime) {
+                nextBoost += mlfqBoostPeriod;
+            }
+        }
+        
+        int current = 0;
+        while (current < levels && queues[current].empty()) {
+            current++;
+        }
+        if (current == levels) {
+            if (nextArrival < arrivals.size()) {
+                currentTime = processes[arrivals[nextArrival]]->arrivalTime;
+                continue;
+            }
+            LOG_WARN("[WARNING] All remaining processes blocked. Terminating.");
+            break;
+        }
+        
+        int idx = queues[current].pop();
+        Process* p = processes[idx];
+        
+        // Check resources with Banker's Algorithm
+        if (banker && !p->hasStarted && !banker->requestResources(p)) {
+            LOG_WARN("[BLOCKED] Process P{} blocked - unsafe state", p->processID);
+            p->isBlocked = true;
+            finishedCount++;
+            continue;
+        }
+        
+        if (!p->hasStarted) {
+            p->startTime = currentTime;
+            p->hasStarted = true;
+        }
+        
+        // Run to the end of the allotment, or until an arrival outranks this
+        // level or a boost is due
+        int sliceEnd = currentTime + min(quanta[current] - used[idx], p->remainingTime);
+        if (current > 0 && nextArrival < arrivals.size()) {
+            sliceEnd = min(sliceEnd, processes[arrivals[nextArrival]]->arrivalTime);
+        }
+        sliceEnd = min(sliceEnd, nextBoost);
+        
+        recordSlice(p, currentTime, sliceEnd);
+        p->remainingTime -= sliceEnd - currentTime;
+        used[idx] += sliceEnd - currentTime;
+        currentTime = sliceEnd;
+        
+        if (p->remainingTime == 0) {
+            finishProcess(p, currentTime);
+            finishedCount++;
+            
+            // Release resources
+            if (banker) {
+                banker->releaseResources(p);
+            }
+        } else if (used[idx] >= quanta[current]) {
+            // Used its whole allotment: demote
+            level[idx] = min(current + 1, levels - 1);
+            used[idx] = 0;
+            queues[level[idx]].push(idx);
+        } else {
+            // Preempted early: keeps its level and what is left of its allotment
+            queues[current].push(idx);
+        }
+    }
+}
+
+void Scheduler::shortestJobScheduling(bool preemptive) {
+    *out << "\n========================================" << endl;
+    if (preemptive) {
+        *out << "EXECUTING: SHORTEST REMAINING TIME FIRST (Preemptive)" << endl;
+    } else {
+        *out << "EXECUTING: SHORTEST JOB FIRST (Non-preemptive)" << endl;
+    }
+    if (predictorAlpha > 0) {
+        *out << "Burst predictor: EMA alpha " << predictorAlpha
+             << ", initial guess " << predictorInitial << endl;
+    }
+    *out << "========================================\n" << endl;
+    
+    int n = processes.size();
+    int currentTime = 0;
+    int finishedCount = 0;  // Completed or blocked
+    
+    // Expected remaining time per process. With the predictor on, it is the
+    // prediction made on arrival less the time run since.
+    vector<double> expected(n);
+    unordered_map<int, double> prediction;  // Priority level -> EMA of bursts
+    
+    vector<int> arrivals = arrivalOrder(finishedCount);
+    size_t nextArrival = 0;
+    
+    auto shorter = [this, &expected](int a, int b) {
+        if (expected[a] != expected[b])
+            return expected[a] < expected[b];
+        if (processes[a]->arrivalTime != processes[b]->arrivalTime)
+            return processes[a]->arrivalTime < processes[b]->arrivalTime;
+        return a < b;
+    };
+    IndexedHeap<decltype(shorter)> readyHeap(n, shorter);
+    
+    int running = -1;
+    int sliceStart = 0;
+    
+    while (finishedCount < n) {
+        // Admit everything that has arrived by now
+        while (nextArrival < arrivals.size() &&
+               processes[arrivals[nextArrival]]->arrivalTime <= currentTime) {
+            int idx = arrivals[nextArrival++];
+            Process* p = processes[idx];
+            if (p->isBlocked) {
+                continue;
+            }
+            if (predictorAlpha > 0) {
+                auto it = prediction.find(p->priority);
+                expected[idx] = (it != prediction.end()) ? it->second : predictorInitial;
+            } else {
+                expected[idx] = p->remainingTime;
+            }
+            readyHeap.push(idx);
+        }
+        
+        // SRTF: a shorter arrival takes the CPU
+        if (preemptive && running >= 0 && !readyHeap.empty() &&
+            expected[readyHeap.top()] < expected[running]) {
+            recordSlice(processes[running], sliceStart, currentTime);
+            readyHeap.push(running);
+            running = -1;
+        }
+        
+        if (running < 0) {
+            while (!readyHeap.empty()) {
+                int idx = readyHeap.pop();
+                Process* p = processes[idx];
+                
+                // Check resource allocation with Banker's Algorithm
+                if (banker && !p->hasStarted && !banker->requestResources(p)) {
+                    LOG_WARN("[BLOCKED] Process P{} blocked - unsafe state", p->processID);
+                    p->isBlocked = true;
+                    finishedCount++;
+                    continue;
+                }
+                running = idx;
+                break;
+            }
+            
+            if (running < 0) {
+                if (nextArrival < arrivals.size()) {
+                    currentTime = max(currentTime, processes[arrivals[nextArrival]]->arrivalTime);
+                    continue;
+                }
+                if (finishedCount < n) {
+                    LOG_WARN("[WARNING] All remaining processes blocked. Terminating.");
+                }
+                break;
+            }
+            
+            Process* p = processes[running];
+            if (!p->hasStarted) {
+                p->startTime = currentTime;
+                p->hasStarted = true;
+            }
+            sliceStart = currentTime;
+        }
+        
+        // Non-preemptive runs to completion; SRTF stops at the next arrival
+        Process* p = processes[running];
+        int runUntil = currentTime + p->remainingTime;
+        if (preemptive && nextArrival < arrivals.size()) {
+            runUntil = min(runUntil, processes[arrivals[nextArrival]]->arrivalTime);
+        }
+        runUntil = max(runUntil, currentTime);
+        p->remainingTime -= runUntil - currentTime;
+        expected[running] = max(expected[running] - (runUntil - currentTime), 0.0);
+        currentTime = runUntil;
+        
+        if (p->remainingTime == 0) {
+            recordSlice(p, sliceStart, currentTime);
+            finishProcess(p, currentTime);
+            finishedCount++;
+            running = -1;
+            
+            if (predictorAlpha > 0) {
+                auto it = prediction.find(p->priority);
+                double previous = (it != prediction.end()) ? it->second : predictorInitial;
+                prediction[p->priority] = predictorAlpha * p->burstTime + (1 - predictorAlpha) * previous;
+            }
+            
+            // Release resources
+            if (banker) {
+                banker->releaseResources(p);
+            }
+        }
+    }
+}
+
+// Each CPU has its own FIFO run queue and time slice. New arrivals are
+// spread over the queues in turn; a CPU that runs out of work takes the back
+// half of the longest queue. All CPUs advance together from event to event
+// (slice end or arrival).
+void Scheduler::smpScheduling() {
+    *out << "\n========================================" << endl;
+    *out << "EXECUTING: SMP ROUND ROBIN SCHEDULING (Preemptive)" << endl;
+    *out << "CPUs: " << numCpus << ", Time Quantum: " << timeQuantum << endl;
+    *out << "========================================\n" << endl;
+    
+    int n = processes.size();
+    int currentTime = 0;
+    int finishedCount = 0;  // Completed or blocked
+    cpuStats.assign(numCpus, CpuStats());
+    steals = 0;
+    migrations = 0;
+    
+    vector<deque<int> > runQueue(numCpus);
+    vector<int> running(numCpus, -1);
+    vector<int> sliceEnd(numCpus, 0);
+    int nextCpu = 0;                     // Run queue for the next arrival
+    
+    vector<int> arrivals = arrivalOrder(finishedCount);
+    size_t nextArrival = 0;
+    
+    // Move the back half of the longest other run queue to cpu
+    auto steal = [&](int cpu) {
+        int victim = -1;
+        for (int c = 0; c < numCpus; c++) {
+            if (c != cpu && !runQueue[c].empty() &&
+                (victim < 0 || runQueue[c].size() > runQueue[victim].size())) {
+                victim = c;
+            }
+        }
+        if (victim < 0) {
+            return false;
+        }
+        deque<int>& from = runQueue[victim];
+        int take = (from.size() + 1) / 2;
+        runQueue[cpu].insert(runQueue[cpu].end(), from.end() - take, from.end());
+        from.erase(from.end() - take, from.end());
+        steals++;
+        migrations += take;
+        cpuStats[cpu].stolen += take;
+        LOG_DEBUG("[SMP] CPU {} stole {} processes from CPU {} at time {}",
+                  cpu, take, victim, currentTime);
+        return true;
+    };
+    
+    // Start the next process from cpu's own queue on cpu
+    auto dispatch = [&](int cpu) {
+        while (!runQueue[cpu].empty()) {
+            int idx = runQueue[cpu].front();
+            runQueue[cpu].pop_front();
+            Process* p = processes[idx];
+            
+            // Check resource allocation with Banker's Algorithm
+            if (banker && !p->hasStarted && !banker->requestResources(p)) {
+                LOG_WARN("[BLOCKED] Process P{} blocked - unsafe state", p->processID);
+                p->isBlocked = true;
+                finishedCount++;
+                continue;
+            }
+            if (!p->hasStarted) {
+                p->startTime = currentTime;
+                p->hasStarted = true;
+            }
+            
+            int executionTime = min(timeQuantum, p->remainingTime);
+            p->remainingTime -= executionTime;
+            running[cpu] = idx;
+            sliceEnd[cpu] = currentTime + executionTime;
+            cpuStats[cpu].busyTime += executionTime;
+            
+            if (executionTime > 0 && recordSlice(p, currentTime, sliceEnd[cpu], cpu)) {
+                cpuStats[cpu].slices++;
+            }
+            return;
+        }
+    };
+    
+    while (finishedCount < n) {
+        // Admit everything that has arrived by now
+        while (nextArrival < arrivals.size() &&
+               processes[arrivals[nextArrival]]->arrivalTime <= currentTime) {
+            int idx = arrivals[nextArrival++];
+            if (processes[idx]->isBlocked) {
+                continue;
+            }
+            runQueue[nextCpu].push_back(idx);
+            nextCpu = (nextCpu + 1) % numCpus;
+        }
+        
+        // Slices ending now: complete or go to the back of the same queue
+        for (int c = 0; c < numCpus; c++) {
+            if (running[c] < 0 || sliceEnd[c] != currentTime) {
+                continue;
+            }
+            Process* p = processes[running[c]];
+            if (p->remainingTime == 0) {
+                finishProcess(p, currentTime);
+                finishedCount++;
+                cpuStats[c].completed++;
+                
+                // Release resources
+                if (banker) {
+                    banker->releaseResources(p);
+                }
+            } else {
+                runQueue[c].push_back(running[c]);
+            }
+            running[c] = -1;
+        }
+        
+        // Idle CPUs take from their own queue first, then steal
+        for (int c = 0; c < numCpus; c++) {
+            if (running[c] < 0) {
+                dispatch(c);
+            }
+        }
+        for (int c = 0; c < numCpus; c++) {
+            while (running[c] < 0 && steal(c)) {
+                dispatch(c);
+            }
+        }
+        
+        // Advance to the next slice end or arrival
+        int nextEvent = INT_MAX;
+        for (int c = 0; c < numCpus; c++) {
+            if (running[c] >= 0) {
+                nextEvent = min(nextEvent, sliceEnd[c]);
+            }
+        }
+        if (nextArrival < arrivals.size()) {
+            nextEvent = min(nextEvent, processes[arrivals[nextArrival]]->arrivalTime);
+        }
+        if (nextEvent == INT_MAX) {
+            if (finishedCount < n) {
+                LOG_WARN("[WARNING] All remaining processes blocked. Terminating.");
+            }
+            break;
+        }
+        currentTime = max(currentTime, nextEvent);
+    }
+    makespan = currentTime;
+}
+
 void Scheduler::executeScheduling() {
     int readyProcessCount = 0;
     for (const auto& p : processes) {
@@ -317,10 +967,10 @@ void Scheduler::executeScheduling() {
         }
     }
     
-    cout << "\n========================================" << endl;
-    cout << "SCHEDULER SELECTION" << endl;
-    cout << "========================================" << endl;
-    cout << "Ready processes at time 0: " << readyProcessCount << endl;
+    *out << "\n========================================" << endl;
+    *out << "SCHEDULER SELECTION" << endl;
+    *out << "========================================" << endl;
+    *out << "Ready processes at time 0: " << readyProcessCount << endl;
     
     for (auto& p : processes) {
         p->remainingTime = p->burstTime;
@@ -328,15 +978,70 @@ void Scheduler::executeScheduling() {
         p->startTime = -1;
     }
     
-    if (readyProcessCount <= 5) {
-        cout << "Condition: <= 5 ready processes" << endl;
-        cout << "Selected: PRIORITY SCHEDULING" << endl;
-        priorityScheduling();
+    GanttEntry closed;
+    closed.cpu = -1;
+    ganttChart.clear();
+    openSlices.assign(numCpus, closed);
+    openProcesses.assign(numCpus, nullptr);
+    ganttEntries = 0;
+    statistics.clear();
+    
+    if (numCpus > 1) {
+        *out << "CPUs: " << numCpus << endl;
+        if (policy != POLICY_AUTO && policy != POLICY_ROUND_ROBIN) {
+            *out << "Note: the requested policy applies to one CPU only" << endl;
+        }
+        *out << "Selected: SMP ROUND ROBIN SCHEDULING" << endl;
+        smpScheduling();
+        closeSlices();
+        Logger::flush();
+        return;
+    }
+    
+    SchedulingPolicy selected = policy;
+    if (selected == POLICY_AUTO) {
+        if (readyProcessCount <= 5) {
+            *out << "Condition: <= 5 ready processes" << endl;
+            selected = POLICY_PRIORITY;
+        } else {
+            *out << "Condition: > 5 ready processes" << endl;
+            selected = POLICY_ROUND_ROBIN;
+        }
     } else {
-        cout << "Condition: > 5 ready processes" << endl;
-        cout << "Selected: ROUND ROBIN SCHEDULING" << endl;
-        roundRobinScheduling();
+        *out << "Policy requested explicitly" << endl;
+    }
+    
+    switch (selected) {
+        case POLICY_ROUND_ROBIN:
+            *out << "Selected: ROUND ROBIN SCHEDULING" << endl;
+            roundRobinScheduling();
+            break;
+        case POLICY_PREEMPTIVE_PRIORITY:
+            *out << "Selected: PREEMPTIVE PRIORITY SCHEDULING" << endl;
+            preemptivePriorityScheduling();
+            break;
+        case POLICY_SJF:
+            *out << "Selected: SHORTEST JOB FIRST SCHEDULING" << endl;
+            shortestJobScheduling(false);
+            break;
+        case POLICY_SRTF:
+            *out << "Selected: SHORTEST REMAINING TIME FIRST SCHEDULING" << endl;
+            shortestJobScheduling(true);
+            break;
+        case POLICY_MLFQ:
+            *out << "Selected: MULTILEVEL FEEDBACK QUEUE SCHEDULING" << endl;
+            mlfqScheduling();
+            break;
+        default:
+            *out << "Selected: PRIORITY SCHEDULING" << endl;
+            priorityScheduling();
+            break;
     }
+    
+    closeSlices();
+    
+    // Print any queued [BLOCKED]/[WARNING] messages before the results
+    Logger::flush();
 }
 
 void Scheduler::displayProcessTable() {
@@ -370,6 +1075,16 @@ void Scheduler::displayGanttChart() {
     cout << "          GANTT CHART" << endl;
     cout << "========================================\n" << endl;
     
+    if (ganttSink) {
+        cout << ganttEntries << " entries streamed to the Gantt sink\n" << endl;
+        return;
+    }
+    
+    if (numCpus > 1) {
+        displayCpuTimelines();
+        return;
+    }
+    
     cout << "|";
     for (const auto& entry : ganttChart) {
         cout << " P" << entry.processID << " |";
@@ -386,38 +1101,144 @@ void Scheduler::displayGanttChart() {
     cout << "\n" << endl;
 }
 
-void Scheduler::displayStatistics() {
+// One Gantt row per CPU; gaps where the CPU was idle show as "--"
+void Scheduler::displayCpuTimelines() {
+    vector<vector<const GanttEntry*> > perCpu(numCpus);
+    for (const auto& entry : ganttChart) {
+        perCpu[entry.cpu].push_back(&entry);
+    }
+    
+    for (int c = 0; c < numCpus; c++) {
+        cout << "CPU " << c << ":" << endl;
+        if (perCpu[c].empty()) {
+            cout << "(idle)\n" << endl;
+            continue;
+        }
+        
+        string bars = "|";
+        string times = "0";
+        int clock = 0;
+        for (const GanttEntry* entry : perCpu[c]) {
+            if (entry->startTime > clock) {
+                bars += " -- |";
+                times += string(4, ' ') + to_string(entry->startTime);
+            }
+            bars += " P" + to_string(entry->processID) + " |";
+            times += string(4, ' ') + to_string(entry->endTime);
+            clock = entry->endTime;
+        }
+        cout << bars << "\n" << times << "\n" << endl;
+    }
+}
+
+void Scheduler::displayCpuStatistics() {
     cout << "========================================" << endl;
-    cout << "       PROCESS STATISTICS" << endl;
+    cout << "       PER-CPU STATISTICS" << endl;
     cout << "========================================" << endl;
-    cout << left << setw(6) << "PID"
-         << setw(15) << "Arrival"
-         << setw(15) << "Burst"
-         << setw(15) << "Completion"
-         << setw(15) << "Waiting"
-         << setw(15) << "Turnaround" << endl;
+    cout << left << setw(6) << "CPU"
+         << setw(10) << "Busy"
+         << setw(13) << "Utilization"
+         << setw(10) << "Slices"
+         << setw(12) << "Completed"
+         << "Stolen" << endl;
     cout << "----------------------------------------" << endl;
     
-    double totalWaitingTime = 0;
-    double totalTurnaroundTime = 0;
+    long totalBusy = 0;
+    int maxBusy = 0;
+    for (int c = 0; c < (int)cpuStats.size(); c++) {
+        const CpuStats& stats = cpuStats[c];
+        double utilization = makespan > 0 ? 100.0 * stats.busyTime / makespan : 0;
+        cout << left << setw(6) << c
+             << setw(10) << stats.busyTime
+             << setw(13) << (to_string((int)(utilization + 0.5)) + "%")
+             << setw(10) << stats.slices
+             << setw(12) << stats.completed
+             << stats.stolen << endl;
+        totalBusy += stats.busyTime;
+        maxBusy = max(maxBusy, stats.busyTime);
+    }
     
-    for (const auto& p : processes) {
-        cout << left << setw(6) << p->processID
-             << setw(15) << p->arrivalTime
-             << setw(15) << p->burstTime
-             << setw(15) << p->completionTime
-             << setw(15) << p->waitingTime
-             << setw(15) << p->turnaroundTime << endl;
-        
-        totalWaitingTime += p->waitingTime;
-        totalTurnaroundTime += p->turnaroundTime;
+    // 1.00 means every CPU did the same amount of work
+    double averageBusy = cpuStats.empty() ? 0 : (double)totalBusy / cpuStats.size();
+    cout << "\nMakespan: " << makespan << endl;
+    cout << "Load Imbalance (max/avg busy): "
+         << (averageBusy > 0 ? maxBusy / averageBusy : 1.0) << endl;
+    cout << "Steals: " << steals << ", Migrations: " << migrations << endl;
+}
+
+void Scheduler::displayStatistics(bool showProcesses) {
+    if (showProcesses) {
+        cout << "========================================" << endl;
+        cout << "       PROCESS STATISTICS" << endl;
+        cout << "========================================" << endl;
+        cout << left << setw(6) << "PID"
+             << setw(15) << "Arrival"
+             << setw(15) << "Burst"
+             << setw(15) << "Completion"
+             << setw(15) << "Waiting"
+             << setw(15) << "Turnaround"
+             << setw(15) << "Response" << endl;
+        cout << "----------------------------------------" << endl;
+    }
+    
+    if (showProcesses) {
+        for (const auto& p : processes) {
+            cout << left << setw(6) << p->processID
+                 << setw(15) << p->arrivalTime
+                 << setw(15) << p->burstTime
+                 << setw(15) << p->completionTime
+                 << setw(15) << p->waitingTime
+                 << setw(15) << p->turnaroundTime;
+            if (p->hasStarted) {
+                cout << setw(15) << p->startTime - p->arrivalTime;
+            } else {
+                cout << setw(15) << "-";
+            }
+            cout << endl;
+        }
     }
     
+    // Averages are over every process, blocked ones counting as zero;
+    // everything else is over the completed ones
     cout << "\n========================================" << endl;
     cout << "       AVERAGE STATISTICS" << endl;
     cout << "========================================" << endl;
     cout << fixed << setprecision(2);
-    cout << "Average Waiting Time: " << (totalWaitingTime / processes.size()) << endl;
-    cout << "Average Turnaround Time: " << (totalTurnaroundTime / processes.size()) << endl;
+    cout << "Average Waiting Time: " << (statistics.totalWaiting() / processes.size()) << endl;
+    cout << "Average Turnaround Time: " << (statistics.totalTurnaround() / processes.size()) << endl;
+    cout << "Average Response Time: " << (statistics.totalResponse() / processes.size()) << endl;
+    
+    if (statistics.completed() > 0) {
+        static const char* names[] = { "Waiting", "Turnaround", "Response" };
+        const LatencyHistogram* histograms[] = {
+            &statistics.waiting(), &statistics.turnaround(), &statistics.response()
+        };
+        
+        cout << "\n" << left << setw(14) << "Percentile" << right
+             << setw(8) << "p50"
+             << setw(8) << "p90"
+             << setw(8) << "p99"
+             << setw(8) << "Max" << endl;
+        cout << "----------------------------------------" << endl;
+        for (int i = 0; i < 3; i++) {
+            cout << left << setw(14) << names[i] << right
+                 << setw(8) << histograms[i]->percentile(0.50)
+                 << setw(8) << histograms[i]->percentile(0.90)
+                 << setw(8) << histograms[i]->percentile(0.99)
+                 << setw(8) << histograms[i]->max() << endl;
+        }
+        cout << left;
+        
+        cout << "\nThroughput: " << setprecision(3) << statistics.throughput()
+             << " processes per time unit" << setprecision(2) << endl;
+        cout << "CPU Utilization: " << 100 * statistics.utilization(numCpus) << "%" << endl;
+        cout << "Context Switches: " << statistics.contextSwitches() << endl;
+        cout << "Jain's Fairness Index (burst/turnaround): " << statistics.fairness() << endl;
+    }
     cout << "========================================\n" << endl;
+    
+    if (numCpus > 1 && !cpuStats.empty()) {
+        displayCpuStatistics();
+        cout << "========================================\n" << endl;
+    }
 }
\ No newline at end of file
@@ -2,34 +2,114 @@
 #define SCHEDULER_H
 
 #include <vector>
+#include <ostream>
 #include "Process.h"
 #include "BankersAlgorithm.h"
+#include "GanttSink.h"
+#include "OnlineStatistics.h"
+
+enum SchedulingPolicy {
+    POLICY_AUTO,                 // Priority if <= 5 processes ready at time 0, else Round Robin
+    POLICY_PRIORITY,
+    POLICY_ROUND_ROBIN,
+    POLICY_PREEMPTIVE_PRIORITY,
+    POLICY_MLFQ,
+    POLICY_SJF,                  // Shortest job first (non-preemptive)
+    POLICY_SRTF                  // Shortest remaining time first (preemptive)
+};
+
+// Per-CPU counters from the last multi-CPU run
+struct CpuStats {
+    int busyTime;
+    int slices;     // Dispatches; a process continuing on the same CPU counts once
+    int completed;
+    int stolen;     // Processes this CPU took from another CPU's run queue
+    
+    CpuStats() : busyTime(0), slices(0), completed(0), stolen(0) {}
+};
 
 class Scheduler {
 private:
     std::vector<Process*> processes;
-    std::vector<GanttEntry> ganttChart;
+    std::vector<GanttEntry> ganttChart;  // Closed slices; stays empty with a sink attached
+    std::vector<GanttEntry> openSlices;  // Per CPU: latest slice, not yet emitted (cpu < 0: none)
+    std::vector<Process*> openProcesses; // Per CPU: process of the open slice
+    GanttSink* ganttSink;                // Receives closed slices instead of ganttChart
+    long ganttEntries;                   // Closed slices in the last run
+    OnlineStatistics statistics;         // Completed processes of the last run
     int timeQuantum;
+    int agingInterval;  // Waiting time per one-level priority boost, 0 = no aging
+    SchedulingPolicy policy;
+    std::vector<int> mlfqQuanta;  // Quantum per MLFQ level, top first; empty = derive from timeQuantum
+    int mlfqBoostPeriod;          // Move everything back to the top level this often, 0 = never
+    double predictorAlpha;        // SJF/SRTF: EMA weight of the last burst, 0 = use burstTime
+    double predictorInitial;      // First guess before any burst has completed
     BankersAlgorithm* banker;
+    int numCpus;
+    std::vector<CpuStats> cpuStats;
+    int steals;      // Work-stealing operations
+    int migrations;  // Processes moved between run queues
+    int makespan;
+    std::ostream* out;  // Progress banners from executeScheduling
     
-    std::vector<int> getReadyProcesses(int currentTime, std::vector<bool>& completed);
     void priorityScheduling();
     void roundRobinScheduling();
+    void preemptivePriorityScheduling();
+    void mlfqScheduling();
+    void shortestJobScheduling(bool preemptive);
+    void smpScheduling();
+    std::vector<int> arrivalOrder(int& blockedCount) const;
+    bool recordSlice(Process* p, int start, int end, int cpu = 0);
+    void emitSlice(const GanttEntry& entry);
+    void closeSlices();
+    void finishProcess(Process* p, int time);
+    void displayCpuTimelines();
+    void displayCpuStatistics();
     
 public:
     Scheduler();
     ~Scheduler();
     
     void addProcess(Process* process);
+    void addProcesses(const std::vector<Process*>& list);
     void setBanker(BankersAlgorithm* bankerAlgo);
+    void sortProcessesByID();
     void executeScheduling();
     void setTimeQuantum(int quantum);
+    void setAgingInterval(int interval);
+    void setPolicy(SchedulingPolicy schedulingPolicy);
+    void setMlfqLevels(const std::vector<int>& quanta, int boostPeriod);
+    
+    // Order SJF/SRTF by an exponential moving average of completed bursts
+    // (one per priority level) instead of the true burstTime
+    void setBurstPredictor(double alpha, double initialGuess);
+    
+    // More than one CPU replaces the selected policy with per-CPU Round
+    // Robin run queues and work stealing
+    void setCpuCount(int cpus);
+    
+    // Where executeScheduling reports its selection; a stream without a
+    // buffer (std::ostream(nullptr)) silences it
+    void setOutput(std::ostream* stream);
+    
+    // Stream Gantt entries to sink as they close instead of keeping them;
+    // nullptr goes back to the in-memory chart. Not owned.
+    void setGanttSink(GanttSink* sink);
+    
+    // Parse "auto", "priority", "rr", "preemptive-priority", "mlfq", "sjf" or "srtf"
+    static bool parsePolicy(const char* name, SchedulingPolicy& schedulingPolicy);
     
     void displayProcessTable();
     void displayGanttChart();
-    void displayStatistics();
+    void displayStatistics(bool showProcesses = true);
     
     int getProcessCount();
+    int getCpuCount() const { return numCpus; }
+    
+    // Entries of the last run; empty if they were streamed to a sink
+    const std::vector<GanttEntry>& getGanttChart() const { return ganttChart; }
+    long getGanttEntryCount() const { return ganttEntries; }
+    const OnlineStatistics& getStatistics() const { return statistics; }
     std::vector<Process*>& getProcesses();
 };
 
@@ -0,0 +1,393 @@
+#include "SimulationConfig.h"
+#include "Logger.h"
+#include <getopt.h>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <algorithm>
+
+using namespace std;
+
+static bool parseInt(const char* text, int minimum, int& value) {
+    char* end;
+    errno = 0;
+    long parsed = strtol(text, &end, 10);
+    if (errno != 0 || end == text || *end != '\0' || parsed < minimum || parsed > 1000000000L) {
+        return false;
+    }
+    value = (int)parsed;
+    return true;
+}
+
+static bool parseSeed(const char* text, uint64_t& value) {
+    char* end;
+    errno = 0;
+    unsigned long long parsed = strtoull(text, &end, 0);
+    if (errno != 0 || end == text || *end != '\0' || *text == '-') {
+        return false;
+    }
+    value = parsed;
+    return true;
+}
+
+// "ALPHA" or "ALPHA:INITIAL", with 0 < ALPHA <= 1 and INITIAL > 0
+static bool parsePredictor(const char* text, double& alpha, double& initial) {
+    char* end;
+    double parsedAlpha = strtod(text, &end);
+    double parsedInitial = initial;
+    if (end == text || !(parsedAlpha > 0 && parsedAlpha <= 1)) {
+        return false;
+    }
+    if (*end == ':') {
+        const char* start = end + 1;
+        parsedInitial = strtod(start, &end);
+        if (end == start || !(parsedInitial > 0)) {
+            return false;
+        }
+    }
+    if (*end != '\0') {
+        return false;
+    }
+    alpha = parsedAlpha;
+    initial = parsedInitial;
+    return true;
+}
+
+// "10,5,7" -> {10, 5, 7}
+static bool parseIntList(const char* text, vector<int>& values) {
+    values.clear();
+    const char* p = text;
+    while (true) {
+        char* end;
+        errno = 0;
+        long parsed = strtol(p, &end, 10);
+        if (errno != 0 || end == p || parsed < 0 || parsed > 1000000000L) {
+            return false;
+        }
+        values.push_back((int)parsed);
+        if (*end == '\0') break;
+        if (*end != ',') return false;
+        p = end + 1;
+    }
+    return !values.empty();
+}
+
+void printUsage(const char* program) {
+    cout << "Usage: " << program << " [options]\n"
+         << "Without options the interactive menu is started.\n\n"
+         << "  -p, --producers N      Producer threads (minimum 2, default 2)\n"
+         << "  -C, --consumers N      Consumer threads (default 1)\n"
+         << "  -b, --buffer-size N    Buffer capacity (default 5)\n"
+         << "  -B, --buffer TYPE      mutex or lockfree (default mutex)\n"
+         << "  -n, --processes N      Processes to generate (default 5)\n"
+         << "  -k, --batch N          Batch size, 1 = no batching (default 1)\n"
+         << "  -q, --quantum N        Round Robin time quantum (default 2)\n"
+         << "  -P, --policy NAME      auto, priority, rr, preemptive-priority, mlfq,\n"
+         << "                         sjf or srtf (default auto)\n"
+         << "  -a, --aging N          Preemptive priority: boost one level per N units waiting\n"
+         << "      --mlfq-quanta LIST MLFQ quantum per level, top first (default Q,2Q,4Q)\n"
+         << "      --mlfq-boost N     MLFQ: move all processes to the top level every N\n"
+         << "                         time units, 0 = never (default 100)\n"
+         << "      --predict A[:G]    SJF/SRTF: order by an EMA of past bursts with weight A\n"
+         << "                         and first guess G (default 5) instead of burstTime\n"
+         << "      --cpus N           Simulate N CPUs with per-CPU Round Robin run queues\n"
+         << "                         and work stealing (default 1)\n"
+         << "      --sweep NAME=V1/V2 Run the workload once per value of a scheduling\n"
+         << "                         option (policy, quantum, aging, mlfq-quanta,\n"
+         << "                         mlfq-boost, predict, cpus or resources) in\n"
+         << "                         parallel; repeat for a cross product\n"
+         << "      --jobs N           Threads for --sweep (default: one per CPU)\n"
+         << "  -r, --resources LIST   Resource totals, e.g. 10,5,7 (default 10,5,7)\n"
+         << "  -S, --seed N           Master random seed; same seed, same workload\n"
+         << "      --arrivals SPEC    zero, poisson:MEAN_GAP or bursty:MEAN_GAP:MEAN_GROUP\n"
+         << "      --bursts SPEC      uniform:MIN:MAX, exponential:MEAN, pareto:ALPHA:MIN\n"
+         << "                         or lognormal:MU:SIGMA (default uniform:1:10)\n"
+         << "      --priorities SPEC  uniform:LEVELS or zipf:S:LEVELS (default uniform:5)\n"
+         << "      --demand SPEC      uniform:MIN:MAX or correlated:MIN:MAX:RHO\n"
+         << "                         (default uniform:1:5)\n"
+         << "  -V, --virtual-time     Advance a simulated clock instead of sleeping;\n"
+         << "                         arrivals are stamped from it (100 ms = 1 unit)\n"
+         << "                         and a full or empty buffer waits in it\n"
+         << "  -t, --trace FILE       Replay a workload trace instead of generating\n"
+         << "  -c, --convert FILE     Convert the --trace file to a binary trace and exit\n"
+         << "  -o, --results FILE     Export results: FILE.json holds processes, Gantt\n"
+         << "                         chart, statistics and Banker state; otherwise\n"
+         << "                         FILE gets the process CSV and the rest goes to\n"
+         << "                         FILE_gantt.csv, FILE_stats.csv, FILE_banker.csv\n"
+         << "      --gantt FILE       Stream the Gantt chart to FILE as CSV while\n"
+         << "                         scheduling, in constant memory\n"
+         << "  -l, --log-level LEVEL  debug, info, warn, error or silent\n"
+         << "  -s, --quiet            Only print the average statistics\n"
+         << "  -h, --help             Show this help\n\n"
+         << "Text traces hold one process per line, separated by spaces or commas:\n"
+         << "  PID ARRIVAL BURST PRIORITY R1 R2 ... Rm\n"
+         << "PIDs must be unique and no requirement may exceed its --resources\n"
+         << "total. Blank lines and lines starting with # are ignored. Binary traces\n"
+         << "written by --convert are detected automatically and memory-mapped." << endl;
+}
+
+// Long-only options
+enum {
+    OPTION_ARRIVALS = 256,
+    OPTION_BURSTS,
+    OPTION_PRIORITIES,
+    OPTION_DEMAND,
+    OPTION_MLFQ_QUANTA,
+    OPTION_MLFQ_BOOST,
+    OPTION_PREDICT,
+    OPTION_CPUS,
+    OPTION_SWEEP,
+    OPTION_JOBS,
+    OPTION_GANTT
+};
+
+static const struct option longOptions[] = {
+    { "producers",   required_argument, NULL, 'p' },
+    { "consumers",   required_argument, NULL, 'C' },
+    { "buffer-size", required_argument, NULL, 'b' },
+    { "buffer",      required_argument, NULL, 'B' },
+    { "processes",   required_argument, NULL, 'n' },
+    { "batch",       required_argument, NULL, 'k' },
+    { "quantum",     required_argument, NULL, 'q' },
+    { "policy",      required_argument, NULL, 'P' },
+    { "aging",       required_argument, NULL, 'a' },
+    { "mlfq-quanta", required_argument, NULL, OPTION_MLFQ_QUANTA },
+    { "mlfq-boost",  required_argument, NULL, OPTION_MLFQ_BOOST },
+    { "predict",     required_argument, NULL, OPTION_PREDICT },
+    { "cpus",        required_argument, NULL, OPTION_CPUS },
+    { "sweep",       required_argument, NULL, OPTION_SWEEP },
+    { "jobs",        required_argument, NULL, OPTION_JOBS },
+    { "resources",   required_argument, NULL, 'r' },
+    { "seed",        required_argument, NULL, 'S' },
+    { "arrivals",    required_argument, NULL, OPTION_ARRIVALS },
+    { "bursts",      required_argument, NULL, OPTION_BURSTS },
+    { "priorities",  required_argument, NULL, OPTION_PRIORITIES },
+    { "demand",      required_argument, NULL, OPTION_DEMAND },
+    { "virtual-time", no_argument,      NULL, 'V' },
+    { "trace",       required_argument, NULL, 't' },
+    { "convert",     required_argument, NULL, 'c' },
+    { "results",     required_argument, NULL, 'o' },
+    { "gantt",       required_argument, NULL, OPTION_GANTT },
+    { "log-level",   required_argument, NULL, 'l' },
+    { "quiet",       no_argument,       NULL, 's' },
+    { "help",        no_argument,       NULL, 'h' },
+    { NULL, 0, NULL, 0 }
+};
+
+// Options that only change how a fixed workload is scheduled, and so may be
+// swept. Returns false for a bad value or any other option.
+static bool applySchedulingOption(int option, const char* value, SimulationConfig& config) {
+    switch (option) {
+        case 'q': return parseInt(value, 1, config.timeQuantum);
+        case 'P': return Scheduler::parsePolicy(value, config.policy);
+        case 'a': return parseInt(value, 0, config.agingInterval);
+        case 'r': return parseIntList(value, config.totalResources);
+        case OPTION_MLFQ_QUANTA:
+            return parseIntList(value, config.mlfqQuanta) &&
+                   *min_element(config.mlfqQuanta.begin(), config.mlfqQuanta.end()) > 0;
+        case OPTION_MLFQ_BOOST: return parseInt(value, 0, config.mlfqBoostPeriod);
+        case OPTION_CPUS: return parseInt(value, 1, config.numCpus);
+        case OPTION_PREDICT:
+            return parsePredictor(value, config.predictorAlpha, config.predictorInitial);
+    }
+    return false;
+}
+
+// "quantum=1/2/4" -> axis over --quantum with three values
+static bool parseSweepAxis(const char* text, SweepAxis& axis, string& error) {
+    const char* equals = strchr(text, '=');
+    if (!equals || equals == text || equals[1] == '\0') {
+        error = string("Invalid value '") + text + "' for --sweep, expected NAME=V1/V2/...";
+        return false;
+    }
+    axis.name.assign(text, equals);
+    axis.option = 0;
+    for (const struct option* entry = longOptions; entry->name; entry++) {
+        if (axis.name == entry->name) axis.option = entry->val;
+    }
+    static const int sweepable[] = { 'q', 'P', 'a', 'r', OPTION_MLFQ_QUANTA, OPTION_MLFQ_BOOST,
+                                     OPTION_CPUS, OPTION_PREDICT };
+    if (find(begin(sweepable), end(sweepable), axis.option) == end(sweepable)) {
+        error = "Cannot sweep '" + axis.name + "'; use policy, quantum, aging, "
+                "mlfq-quanta, mlfq-boost, predict, cpus or resources";
+        return false;
+    }
+    
+    axis.values.clear();
+    string values = equals + 1;
+    size_t start = 0;
+    while (true) {
+        size_t slash = values.find('/', start);
+        axis.values.push_back(values.substr(start, slash - start));
+        if (slash == string::npos) break;
+        start = slash + 1;
+    }
+    
+    SimulationConfig scratch;
+    for (const string& value : axis.values) {
+        if (!applySchedulingOption(axis.option, value.c_str(), scratch)) {
+            error = "Invalid value '" + value + "' for --" + axis.name;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool parseCommandLine(int argc, char* argv[], SimulationConfig& config,
+                      bool& showHelp, string& error) {
+    showHelp = false;
+    opterr = 0;
+    optind = 1;
+
+    int option;
+    while ((option = getopt_long(argc, argv, ":p:C:b:B:n:k:q:P:a:r:S:Vt:c:o:l:sh", longOptions, NULL)) != -1) {
+        bool valid = true;
+        switch (option) {
+            case 'p': valid = parseInt(optarg, 2, config.numProducers); break;
+            case 'C': valid = parseInt(optarg, 1, config.numConsumers); break;
+            case 'b': valid = parseInt(optarg, 1, config.bufferSize); break;
+            case 'n': valid = parseInt(optarg, 1, config.totalProcesses); break;
+            case 'k': valid = parseInt(optarg, 1, config.batchSize); break;
+            case 'q':
+            case 'P':
+            case 'a':
+            case 'r':
+            case OPTION_MLFQ_QUANTA:
+            case OPTION_MLFQ_BOOST:
+            case OPTION_CPUS:
+            case OPTION_PREDICT:
+                valid = applySchedulingOption(option, optarg, config);
+                break;
+            case 'S': valid = parseSeed(optarg, config.seed); config.hasSeed = valid; break;
+            case 't': config.traceFile = optarg; break;
+            case 'c': config.convertFile = optarg; break;
+            case 'o': config.resultsFile = optarg; break;
+            case OPTION_GANTT: config.ganttFile = optarg; break;
+            case 'V': config.virtualTime = true; break;
+            case 's': config.quiet = true; break;
+            case 'h': showHelp = true; return true;
+            case 'B':
+                if (strcmp(optarg, "mutex") == 0) {
+                    config.bufferType = BUFFER_MUTEX;
+                } else if (strcmp(optarg, "lockfree") == 0) {
+                    config.bufferType = BUFFER_LOCK_FREE;
+                } else {
+                    valid = false;
+                }
+                break;
+            case OPTION_SWEEP: {
+                SweepAxis axis;
+                if (!parseSweepAxis(optarg, axis, error)) return false;
+                config.sweep.push_back(axis);
+                break;
+            }
+            case OPTION_JOBS: valid = parseInt(optarg, 1, config.sweepThreads); break;
+            case OPTION_ARRIVALS:
+                if (!config.workload.setArrivals(optarg, error)) return false;
+                break;
+            case OPTION_BURSTS:
+                if (!config.workload.setBursts(optarg, error)) return false;
+                break;
+            case OPTION_PRIORITIES:
+                if (!config.workload.setPriorities(optarg, error)) return false;
+                break;
+            case OPTION_DEMAND:
+                if (!config.workload.setDemand(optarg, error)) return false;
+                break;
+            case 'l': {
+                LogLevel level;
+                valid = Logger::parseLevel(optarg, level);
+                if (valid) Logger::setLevel(level);
+                break;
+            }
+            case ':':
+                error = string("Missing value for ") + argv[optind - 1];
+                return false;
+            default:
+                error = string("Unknown option ") + argv[optind - 1];
+                return false;
+        }
+        if (!valid) {
+            error = string("Invalid value '") + optarg + "' for ";
+            if (option < OPTION_ARRIVALS) {
+                error += string("-") + (char)option;
+            } else {
+                for (const struct option* entry = longOptions; entry->name; entry++) {
+                    if (entry->val == option) error += string("--") + entry->name;
+                }
+            }
+            return false;
+        }
+    }
+
+    if (optind < argc) {
+        error = string("Unexpected argument ") + argv[optind];
+        return false;
+    }
+    if (!config.convertFile.empty() && config.traceFile.empty()) {
+        error = "--convert needs a --trace file to read";
+        return false;
+    }
+    if (!config.sweep.empty() && !config.resultsFile.empty()) {
+        error = "--results writes a single run and cannot be combined with --sweep";
+        return false;
+    }
+    if (!config.sweep.empty() && !config.ganttFile.empty()) {
+        error = "--gantt writes a single run and cannot be combined with --sweep";
+        return false;
+    }
+    // A generated process needing more than a resource's total is never granted
+    if (config.traceFile.empty()) {
+        for (size_t i = 0; i < config.totalResources.size(); i++) {
+            if (config.workload.maxDemand() > config.totalResources[i]) {
+                error = "--demand allows up to " + to_string(config.workload.maxDemand()) +
+                        " of R" + to_string(i + 1) + ", more than its total of " +
+                        to_string(config.totalResources[i]);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void configureScheduler(Scheduler& scheduler, const SimulationConfig& config) {
+    scheduler.setTimeQuantum(config.timeQuantum);
+    scheduler.setPolicy(config.policy);
+    scheduler.setAgingInterval(config.agingInterval);
+    scheduler.setMlfqLevels(config.mlfqQuanta, config.mlfqBoostPeriod);
+    scheduler.setBurstPredictor(config.predictorAlpha, config.predictorInitial);
+    scheduler.setCpuCount(config.numCpus);
+}
+
+bool expandSweep(const SimulationConfig& base, vector<SimulationConfig>& scenarios,
+                 vector<string>& labels, string& error) {
+    scenarios.assign(1, base);
+    labels.assign(1, "");
+    
+    for (const SweepAxis& axis : base.sweep) {
+        vector<SimulationConfig> expanded;
+        vector<string> expandedLabels;
+        for (size_t i = 0; i < scenarios.size(); i++) {
+            for (const string& value : axis.values) {
+                SimulationConfig scenario = scenarios[i];
+                applySchedulingOption(axis.option, value.c_str(), scenario);
+                if (scenario.totalResources.size() != base.totalResources.size()) {
+                    error = "--sweep resources=" + value + " has " +
+                            to_string(scenario.totalResources.size()) + " resource types, the workload has " +
+                            to_string(base.totalResources.size());
+                    return false;
+                }
+                expanded.push_back(scenario);
+                expandedLabels.push_back(labels[i] + (labels[i].empty() ? "" : " ") +
+                                         axis.name + "=" + value);
+            }
+        }
+        scenarios.swap(expanded);
+        labels.swap(expandedLabels);
+    }
+    for (SimulationConfig& scenario : scenarios) {
+        scenario.sweep.clear();
+    }
+    return true;
+}
@@ -0,0 +1,78 @@
+#ifndef SIMULATION_CONFIG_H
+#define SIMULATION_CONFIG_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "WorkloadModel.h"
+#include "Scheduler.h"
+
+enum BufferType {
+    BUFFER_MUTEX = 1,     // BoundedBuffer (semaphores + mutex)
+    BUFFER_LOCK_FREE = 2  // LockFreeBuffer
+};
+
+// One --sweep dimension: a scheduling option and the values to try
+struct SweepAxis {
+    int option;                       // Option code, as for the matching flag
+    std::string name;                 // Long option name
+    std::vector<std::string> values;
+};
+
+// Everything one simulation run needs. Filled either from the interactive
+// menu or from the command line.
+struct SimulationConfig {
+    int numProducers;
+    int numConsumers;
+    int bufferSize;
+    BufferType bufferType;
+    int totalProcesses;
+    int batchSize;
+    int timeQuantum;
+    SchedulingPolicy policy;
+    int agingInterval;        // Preemptive priority: wait per one-level boost
+    std::vector<int> mlfqQuanta;  // MLFQ quantum per level; empty = derived
+    int mlfqBoostPeriod;
+    double predictorAlpha;    // SJF/SRTF burst predictor, 0 = off
+    double predictorInitial;
+    int numCpus;              // > 1 runs the multi-CPU scheduler
+    std::vector<int> totalResources;
+    uint64_t seed;            // Master seed for all generator threads
+    bool hasSeed;             // seed was given; otherwise one is picked per run
+    WorkloadModel workload;   // Distributions for generated processes
+    bool virtualTime;         // Producer/consumer pauses use a simulated clock
+
+    std::string traceFile;    // Replay this workload instead of generating one
+    std::string resultsFile;  // Export results as JSON (.json) or CSV files
+    std::string ganttFile;    // Stream Gantt entries here instead of keeping them
+    std::string convertFile;  // Write traceFile as a binary trace and stop
+    bool quiet;               // Only print the average statistics
+    
+    std::vector<SweepAxis> sweep;  // Non-empty: run every combination in parallel
+    int sweepThreads;              // 0 = one per online CPU
+
+    SimulationConfig() : numProducers(2), numConsumers(1), bufferSize(5), bufferType(BUFFER_MUTEX),
+                         totalProcesses(5), batchSize(1), timeQuantum(2),
+                         policy(POLICY_AUTO), agingInterval(0), mlfqBoostPeriod(100),
+                         predictorAlpha(0), predictorInitial(5), numCpus(1),
+                         totalResources({10, 5, 7}), seed(0), hasSeed(false),
+                         virtualTime(false), quiet(false), sweepThreads(0) {}
+};
+
+// Parse command-line flags into config. Returns false and fills error on a
+// bad flag or value; sets showHelp for --help.
+bool parseCommandLine(int argc, char* argv[], SimulationConfig& config,
+                      bool& showHelp, std::string& error);
+
+void printUsage(const char* program);
+
+// Apply config's scheduling options (policy, quantum, CPUs, ...) to scheduler
+void configureScheduler(Scheduler& scheduler, const SimulationConfig& config);
+
+// Every combination of the sweep axes applied to base, with a label such as
+// "policy=rr quantum=4" for each. Returns false if a scenario would not fit
+// the workload (a resource list of a different length).
+bool expandSweep(const SimulationConfig& base, std::vector<SimulationConfig>& scenarios,
+                 std::vector<std::string>& labels, std::string& error);
+
+#endif
@@ -0,0 +1,138 @@
+#include "VirtualTimeline.h"
+#include <algorithm>
+
+using namespace std;
+
+VirtualTimeline::VirtualTimeline(int count, int bufferCapacity)
+    : participants(count), capacity(bufferCapacity), occupancy(0), holder(-1) {
+    pthread_mutex_init(&mutex, NULL);
+    for (Participant& p : participants) {
+        p.time = 0;
+        p.state = LOCAL;
+        pthread_cond_init(&p.wake, NULL);
+    }
+}
+
+VirtualTimeline::~VirtualTimeline() {
+    for (Participant& p : participants) {
+        pthread_cond_destroy(&p.wake);
+    }
+    pthread_mutex_destroy(&mutex);
+}
+
+// The participant that goes next: the lowest (time, id) among those that are
+// not waiting on the buffer. -1 if every participant is waiting or done.
+int VirtualTimeline::earliest() const {
+    int best = -1;
+    for (int i = 0; i < (int)participants.size(); i++) {
+        const Participant& p = participants[i];
+        if ((p.state == LOCAL || p.state == READY) &&
+            (best < 0 || p.time < participants[best].time)) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+// Hand the free turn to the earliest participant if it is already asking;
+// a LOCAL one picks it up when it next calls begin
+void VirtualTimeline::wakeEarliest() {
+    if (holder >= 0) {
+        return;
+    }
+    int next = earliest();
+    if (next >= 0 && participants[next].state == READY) {
+        pthread_cond_signal(&participants[next].wake);
+    }
+}
+
+void VirtualTimeline::waitForTurn(int id) {
+    participants[id].state = READY;
+    wakeEarliest();
+    while (holder >= 0 || earliest() != id) {
+        pthread_cond_wait(&participants[id].wake, &mutex);
+    }
+}
+
+// Everyone waiting in state continues, no earlier than time
+void VirtualTimeline::resume(State waiting, long long time) {
+    for (Participant& p : participants) {
+        if (p.state == waiting) {
+            p.time = max(p.time, time);
+            p.state = READY;
+        }
+    }
+}
+
+int VirtualTimeline::beginInsert(int id, long long& now, int count) {
+    pthread_mutex_lock(&mutex);
+    Participant& self = participants[id];
+    self.time = max(self.time, now);
+    
+    waitForTurn(id);
+    while (occupancy == capacity) {
+        // Full: sleep until a consumer's turn frees a slot
+        self.state = WAIT_SLOT;
+        wakeEarliest();
+        while (self.state == WAIT_SLOT) {
+            pthread_cond_wait(&self.wake, &mutex);
+        }
+        waitForTurn(id);
+    }
+    
+    int taken = min(count, capacity - occupancy);
+    occupancy += taken;
+    holder = id;
+    now = self.time;
+    resume(WAIT_PROCESS, self.time);
+    pthread_mutex_unlock(&mutex);
+    return taken;
+}
+
+int VirtualTimeline::beginRemove(int id, long long& now, int count, atomic<int>* unclaimed) {
+    pthread_mutex_lock(&mutex);
+    Participant& self = participants[id];
+    self.time = max(self.time, now);
+    
+    waitForTurn(id);
+    while (occupancy == 0 && unclaimed->load(memory_order_relaxed) > 0) {
+        // Empty: sleep until a producer's turn adds a process
+        self.state = WAIT_PROCESS;
+        wakeEarliest();
+        while (self.state == WAIT_PROCESS) {
+            pthread_cond_wait(&self.wake, &mutex);
+        }
+        waitForTurn(id);
+    }
+    
+    int left = unclaimed->load(memory_order_relaxed);
+    if (left == 0) {
+        self.state = DONE;
+        wakeEarliest();
+        pthread_mutex_unlock(&mutex);
+        return 0;
+    }
+    int taken = min(count, occupancy);
+    unclaimed->store(left - taken, memory_order_relaxed);
+    occupancy -= taken;
+    holder = id;
+    now = self.time;
+    resume(WAIT_SLOT, self.time);
+    pthread_mutex_unlock(&mutex);
+    return taken;
+}
+
+void VirtualTimeline::end(int id) {
+    pthread_mutex_lock(&mutex);
+    participants[id].state = LOCAL;
+    holder = -1;
+    wakeEarliest();
+    pthread_mutex_unlock(&mutex);
+}
+
+void VirtualTimeline::finish(int id) {
+    pthread_mutex_lock(&mutex);
+    participants[id].state = DONE;
+    wakeEarliest();
+    pthread_mutex_unlock(&mutex);
+}
@@ -0,0 +1,70 @@
+#ifndef VIRTUAL_TIMELINE_H
+#define VIRTUAL_TIMELINE_H
+
+#include <pthread.h>
+#include <atomic>
+#include <vector>
+
+// Shared simulated time for the producers and consumers of a virtual-time
+// run. Buffer operations take turns in (simulated time, participant) order
+// and a model of the buffer's fill level decides who would have blocked: a
+// producer that finds it full resumes at the time of the removal that frees
+// a slot, a consumer that finds it empty at the time of the next insert.
+// Waiting on a slow consumer therefore delays later arrivals as it does in
+// real time, and because the order depends only on simulated time the run
+// stays reproducible.
+//
+// Participants are numbered 0 .. count - 1 (producers first, then
+// consumers). Each begin call that returns a positive count holds the turn
+// until end(); the real buffer operation in between never blocks.
+class VirtualTimeline {
+private:
+    enum State {
+        LOCAL,          // Working between buffer operations; time is a lower bound
+        READY,          // Waiting for its turn
+        WAIT_SLOT,      // Producer waiting for a removal
+        WAIT_PROCESS,   // Consumer waiting for an insert
+        DONE
+    };
+    
+    struct Participant {
+        long long time;  // Simulated microseconds
+        State state;
+        pthread_cond_t wake;
+    };
+    
+    pthread_mutex_t mutex;
+    std::vector<Participant> participants;
+    int capacity;
+    int occupancy;   // Processes in the buffer, as of the last turn
+    int holder;      // Participant holding the turn, -1 if none
+    
+    int earliest() const;
+    void wakeEarliest();
+    void waitForTurn(int id);
+    void resume(State waiting, long long time);
+    
+    VirtualTimeline(const VirtualTimeline&);
+    VirtualTimeline& operator=(const VirtualTimeline&);
+    
+public:
+    VirtualTimeline(int count, int bufferCapacity);
+    ~VirtualTimeline();
+    
+    // Producer id wants to insert count processes at simulated time now.
+    // Returns how many fit once it is id's turn; now is moved past any wait.
+    int beginInsert(int id, long long& now, int count);
+    
+    // Consumer id wants up to count processes at simulated time now. Claims
+    // them from unclaimed and returns how many, or 0 once nothing is left to
+    // claim (the participant is then done).
+    int beginRemove(int id, long long& now, int count, std::atomic<int>* unclaimed);
+    
+    // The buffer operation of the current turn is complete
+    void end(int id);
+    
+    // id will not touch the buffer again
+    void finish(int id);
+};
+
+#endif
@@ -0,0 +1,233 @@
+#include "WorkloadModel.h"
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+
+using namespace std;
+
+// Split "name:1.5:2" into name and its numeric parameters
+static bool splitSpec(const string& spec, string& name, vector<double>& params) {
+    params.clear();
+    size_t colon = spec.find(':');
+    name = spec.substr(0, colon);
+    while (colon != string::npos) {
+        size_t next = spec.find(':', colon + 1);
+        string field = spec.substr(colon + 1, next == string::npos ? string::npos : next - colon - 1);
+        char* end;
+        double value = strtod(field.c_str(), &end);
+        if (field.empty() || *end != '\0' || !std::isfinite(value)) {
+            return false;
+        }
+        params.push_back(value);
+        colon = next;
+    }
+    return true;
+}
+
+static bool badSpec(const string& what, const string& spec, const string& usage, string& error) {
+    error = "Invalid " + what + " spec '" + spec + "', expected " + usage;
+    return false;
+}
+
+WorkloadModel::WorkloadModel()
+    : arrivalSpec("zero"), burstSpec("uniform:1:10"), prioritySpec("uniform:5"),
+      demandSpec("uniform:1:5"),
+      arrivalKind(ARRIVAL_ZERO), meanGap(0), meanGroup(1),
+      burstKind(BURST_UNIFORM), burstA(1), burstB(10),
+      priorityKind(PRIORITY_UNIFORM), priorityLevels(5), zipfExponent(0),
+      demandKind(DEMAND_UNIFORM), demandMin(1), demandMax(5), demandRho(0) {}
+
+bool WorkloadModel::setArrivals(const string& spec, string& error) {
+    static const char* usage = "zero, poisson:MEAN_GAP or bursty:MEAN_GAP:MEAN_GROUP";
+    string name;
+    vector<double> p;
+    if (!splitSpec(spec, name, p)) return badSpec("arrivals", spec, usage, error);
+
+    if (name == "zero" && p.empty()) {
+        arrivalKind = ARRIVAL_ZERO;
+    } else if (name == "poisson" && p.size() == 1 && p[0] > 0) {
+        arrivalKind = ARRIVAL_POISSON;
+        meanGap = p[0];
+    } else if (name == "bursty" && p.size() == 2 && p[0] > 0 && p[1] >= 1) {
+        arrivalKind = ARRIVAL_BURSTY;
+        meanGap = p[0];
+        meanGroup = p[1];
+    } else {
+        return badSpec("arrivals", spec, usage, error);
+    }
+    arrivalSpec = spec;
+    return true;
+}
+
+bool WorkloadModel::setBursts(const string& spec, string& error) {
+    static const char* usage = "uniform:MIN:MAX, exponential:MEAN, pareto:ALPHA:MIN or lognormal:MU:SIGMA";
+    string name;
+    vector<double> p;
+    if (!splitSpec(spec, name, p)) return badSpec("bursts", spec, usage, error);
+
+    if (name == "uniform" && p.size() == 2 && p[0] >= 1 && p[1] >= p[0] && p[1] <= MAX_BURST) {
+        burstKind = BURST_UNIFORM;
+    } else if (name == "exponential" && p.size() == 1 && p[0] > 0) {
+        burstKind = BURST_EXPONENTIAL;
+        p.push_back(0);
+    } else if (name == "pareto" && p.size() == 2 && p[0] > 0 && p[1] >= 1) {
+        burstKind = BURST_PARETO;
+    } else if (name == "lognormal" && p.size() == 2 && p[1] >= 0) {
+        burstKind = BURST_LOGNORMAL;
+    } else {
+        return badSpec("bursts", spec, usage, error);
+    }
+    burstA = p[0];
+    burstB = p[1];
+    burstSpec = spec;
+    return true;
+}
+
+bool WorkloadModel::setPriorities(const string& spec, string& error) {
+    static const char* usage = "uniform:LEVELS or zipf:S:LEVELS";
+    string name;
+    vector<double> p;
+    if (!splitSpec(spec, name, p)) return badSpec("priorities", spec, usage, error);
+
+    if (name == "uniform" && p.size() == 1 && p[0] >= 1 && p[0] <= 1000) {
+        priorityKind = PRIORITY_UNIFORM;
+        priorityLevels = (int)p[0];
+    } else if (name == "zipf" && p.size() == 2 && p[0] >= 0 && p[1] >= 1 && p[1] <= 1000) {
+        priorityKind = PRIORITY_ZIPF;
+        zipfExponent = p[0];
+        priorityLevels = (int)p[1];
+
+        // Cumulative weights of 1/k^s, normalised to end at 1
+        zipfCdf.resize(priorityLevels);
+        double sum = 0;
+        for (int k = 1; k <= priorityLevels; k++) {
+            sum += 1.0 / pow((double)k, zipfExponent);
+            zipfCdf[k - 1] = sum;
+        }
+        for (double& c : zipfCdf) c /= sum;
+    } else {
+        return badSpec("priorities", spec, usage, error);
+    }
+    prioritySpec = spec;
+    return true;
+}
+
+bool WorkloadModel::setDemand(const string& spec, string& error) {
+    static const char* usage = "uniform:MIN:MAX or correlated:MIN:MAX:RHO";
+    string name;
+    vector<double> p;
+    if (!splitSpec(spec, name, p)) return badSpec("demand", spec, usage, error);
+
+    bool range = p.size() >= 2 && p[0] >= 0 && p[1] >= p[0] && p[1] <= 1000000;
+    if (name == "uniform" && p.size() == 2 && range) {
+        demandKind = DEMAND_UNIFORM;
+        demandRho = 0;
+    } else if (name == "correlated" && p.size() == 3 && range && p[2] >= 0 && p[2] <= 1) {
+        demandKind = DEMAND_CORRELATED;
+        demandRho = p[2];
+    } else {
+        return badSpec("demand", spec, usage, error);
+    }
+    demandMin = (int)p[0];
+    demandMax = (int)p[1];
+    demandSpec = spec;
+    return true;
+}
+
+string WorkloadModel::describe() const {
+    return "arrivals=" + arrivalSpec + " bursts=" + burstSpec +
+           " priorities=" + prioritySpec + " demand=" + demandSpec;
+}
+
+int WorkloadModel::nextArrival(Stream& stream) const {
+    Random& random = stream.random;
+    switch (arrivalKind) {
+        case ARRIVAL_POISSON:
+            stream.clock += -meanGap * stream.share * log(1.0 - random.uniformReal());
+            break;
+        case ARRIVAL_BURSTY:
+            if (stream.groupLeft == 0) {
+                stream.clock += -meanGap * stream.share * log(1.0 - random.uniformReal());
+                // Geometric group size with the requested mean
+                stream.groupLeft = 1;
+                if (meanGroup > 1) {
+                    double u = random.uniformReal();
+                    stream.groupLeft += (int)floor(log(1.0 - u) / log(1.0 - 1.0 / meanGroup));
+                }
+            }
+            stream.groupLeft--;
+            break;
+        case ARRIVAL_ZERO:
+            return 0;
+    }
+    stream.clock = min(stream.clock, 1e9);
+    return (int)stream.clock;
+}
+
+// Draws by inverse transform where possible; quantile is the draw's position
+// in the burst distribution, used to correlate resource demand with it
+int WorkloadModel::sampleBurst(Random& random, double& quantile) const {
+    double value;
+    if (burstKind == BURST_LOGNORMAL) {
+        // Box-Muller; quantile is the normal CDF of the draw
+        double u1 = 1.0 - random.uniformReal();
+        double u2 = random.uniformReal();
+        double z = sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+        quantile = 0.5 * erfc(-z / sqrt(2.0));
+        value = exp(burstA + burstB * z);
+    } else {
+        double u = random.uniformReal();
+        quantile = u;
+        switch (burstKind) {
+            case BURST_EXPONENTIAL:
+                value = -burstA * log(1.0 - u);
+                break;
+            case BURST_PARETO:
+                value = burstB / pow(1.0 - u, 1.0 / burstA);
+                break;
+            default:
+                value = burstA + floor(u * (burstB - burstA + 1));
+                break;
+        }
+    }
+    if (!(value < MAX_BURST)) return MAX_BURST;
+    return max(1, (int)(value + 0.5));
+}
+
+int WorkloadModel::samplePriority(Random& random) const {
+    if (priorityKind == PRIORITY_ZIPF) {
+        double u = random.uniformReal();
+        int level = lower_bound(zipfCdf.begin(), zipfCdf.end(), u) - zipfCdf.begin();
+        return min(level, priorityLevels - 1) + 1;
+    }
+    return random.uniform(1, priorityLevels);
+}
+
+Process WorkloadModel::generate(int processID, int numResources, Stream& stream) const {
+    Random& random = stream.random;
+    Process p;
+    p.processID = processID;
+    p.arrivalTime = nextArrival(stream);
+
+    double quantile;
+    p.burstTime = sampleBurst(random, quantile);
+    p.priority = samplePriority(random);
+
+    p.resourceRequirements.resize(numResources);
+    for (int i = 0; i < numResources; i++) {
+        if (demandKind == DEMAND_CORRELATED) {
+            double mix = demandRho * quantile + (1.0 - demandRho) * random.uniformReal();
+            int demand = demandMin + (int)(mix * (demandMax - demandMin + 1));
+            p.resourceRequirements[i] = min(demand, demandMax);
+        } else {
+            p.resourceRequirements[i] = random.uniform(demandMin, demandMax);
+        }
+    }
+
+    p.remainingTime = p.burstTime;
+    p.hasStarted = false;
+    p.startTime = -1;
+    p.isBlocked = false;
+
+    return p;
+}
@@ -0,0 +1,92 @@
+#ifndef WORKLOAD_MODEL_H
+#define WORKLOAD_MODEL_H
+
+#include <string>
+#include <vector>
+#include "Process.h"
+#include "Random.h"
+
+// Distributions the process generator draws from. The defaults reproduce the
+// original generator: everything arrives at time 0, bursts are uniform 1-10,
+// priorities uniform 1-5 and each resource demand uniform 1-5.
+//
+// Each is set from a short spec string:
+//   arrivals:   zero | poisson:MEAN_GAP | bursty:MEAN_GAP:MEAN_GROUP
+//   bursts:     uniform:MIN:MAX | exponential:MEAN | pareto:ALPHA:MIN |
+//               lognormal:MU:SIGMA
+//   priorities: uniform:LEVELS | zipf:S:LEVELS
+//   demand:     uniform:MIN:MAX | correlated:MIN:MAX:RHO
+//
+// Bursts are clamped to [1, MAX_BURST]. Zipf makes priority 1 the most
+// common. Correlated demand mixes the burst's quantile into every resource
+// with weight RHO, so long jobs ask for more of everything.
+class WorkloadModel {
+public:
+    static const int MAX_BURST = 10000;
+
+    enum ArrivalKind { ARRIVAL_ZERO, ARRIVAL_POISSON, ARRIVAL_BURSTY };
+    enum BurstKind { BURST_UNIFORM, BURST_EXPONENTIAL, BURST_PARETO, BURST_LOGNORMAL };
+    enum PriorityKind { PRIORITY_UNIFORM, PRIORITY_ZIPF };
+    enum DemandKind { DEMAND_UNIFORM, DEMAND_CORRELATED };
+
+    // Per-thread generator state. With `share` generators feeding one
+    // system, each runs its arrival process share times slower so that
+    // together they produce the configured rate.
+    struct Stream {
+        Random random;
+        double clock;    // Arrival time of the last process
+        int groupLeft;   // Processes left in the current bursty group
+        int share;
+
+        Stream(const Random& rng, int generators)
+            : random(rng), clock(0), groupLeft(0), share(generators > 0 ? generators : 1) {}
+    };
+
+    WorkloadModel();
+
+    bool setArrivals(const std::string& spec, std::string& error);
+    bool setBursts(const std::string& spec, std::string& error);
+    bool setPriorities(const std::string& spec, std::string& error);
+    bool setDemand(const std::string& spec, std::string& error);
+
+    Process generate(int processID, int numResources, Stream& stream) const;
+
+    // False when every process arrives at time 0
+    bool hasArrivals() const { return arrivalKind != ARRIVAL_ZERO; }
+
+    // Largest requirement a generated process can have for any resource
+    int maxDemand() const { return demandMax; }
+
+    // The four specs in effect, for printing with the results
+    std::string describe() const;
+
+private:
+    std::string arrivalSpec;
+    std::string burstSpec;
+    std::string prioritySpec;
+    std::string demandSpec;
+
+    ArrivalKind arrivalKind;
+    double meanGap;
+    double meanGroup;
+
+    BurstKind burstKind;
+    double burstA;  // MIN, MEAN, ALPHA or MU
+    double burstB;  // MAX, MIN or SIGMA
+
+    PriorityKind priorityKind;
+    int priorityLevels;
+    double zipfExponent;
+    std::vector<double> zipfCdf;
+
+    DemandKind demandKind;
+    int demandMin;
+    int demandMax;
+    double demandRho;
+
+    int nextArrival(Stream& stream) const;
+    int sampleBurst(Random& random, double& quantile) const;
+    int samplePriority(Random& random) const;
+};
+
+#endif
@@ -0,0 +1,301 @@
+#include "WorkloadTrace.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <cctype>
+#include <unordered_map>
+
+static const char TRACE_MAGIC[8] = { 'C', 'C', 'P', 'T', 'R', 'A', 'C', 'E' };
+
+using namespace std;
+
+static bool isSeparator(char c) {
+    return c == ' ' || c == '\t' || c == ',' || c == '\r' || c == '\n';
+}
+
+// Read the next whitespace- or comma-separated integer from p. Returns false
+// at the end of the line or on a malformed field.
+static bool nextField(const char*& p, long& value, bool& malformed) {
+    while (isSeparator(*p)) p++;
+    if (*p == '\0') {
+        malformed = false;
+        return false;
+    }
+    char* end;
+    errno = 0;
+    value = strtol(p, &end, 10);
+    if (end == p || errno != 0 || value < -1000000000L || value > 1000000000L ||
+        (*end != '\0' && !isSeparator(*end))) {
+        malformed = true;
+        return false;
+    }
+    p = end;
+    return true;
+}
+
+// Why a record with these fields cannot be scheduled, or "" if it can. The
+// fields are laid out as in a binary record (MappedTrace::Field).
+// firstRecords maps each PID seen so far to the record ("line" or "record"
+// number, as unit says) that introduced it.
+template <typename FieldType>
+static string recordProblem(const FieldType* fields, const vector<int>& totalResources,
+                            unordered_map<long, int>& firstRecords, int record, const char* unit) {
+    if (fields[MappedTrace::ARRIVAL] < 0 || fields[MappedTrace::BURST] < 0) {
+        return "negative arrival or burst time";
+    }
+    for (size_t i = 0; i < totalResources.size(); i++) {
+        long requirement = fields[MappedTrace::RESOURCES + i];
+        if (requirement < 0) {
+            return "negative resource requirement";
+        }
+        if (requirement > totalResources[i]) {
+            return "R" + to_string(i + 1) + " requirement " + to_string(requirement) +
+                   " exceeds its total of " + to_string(totalResources[i]);
+        }
+    }
+    auto seen = firstRecords.insert(make_pair((long)fields[MappedTrace::PID], record));
+    if (!seen.second) {
+        return "duplicate PID " + to_string((long)fields[MappedTrace::PID]) +
+               string(" (first on ") + unit + " " + to_string(seen.first->second) + ")";
+    }
+    return "";
+}
+
+bool loadTextTrace(const string& path, const vector<int>& totalResources,
+                   vector<Process*>& processes, string& error) {
+    int numResources = totalResources.size();
+    FILE* file = fopen(path.c_str(), "r");
+    if (!file) {
+        error = "Cannot open trace file " + path;
+        return false;
+    }
+
+    vector<Process*> loaded;
+    vector<long> fields;
+    unordered_map<long, int> firstLines;
+    char line[4096];
+    int lineNumber = 0;
+    bool ok = true;
+    bool firstRow = true;
+
+    while (ok && fgets(line, sizeof(line), file)) {
+        lineNumber++;
+        const char* p = line;
+        while (*p == ' ' || *p == '\t') p++;
+        if (*p == '#' || *p == '\n' || *p == '\r' || *p == '\0') {
+            continue;
+        }
+
+        // A CSV header row such as "pid,arrival,burst,..."
+        if (firstRow && isalpha((unsigned char)*p)) {
+            firstRow = false;
+            continue;
+        }
+        firstRow = false;
+
+        fields.clear();
+        long value;
+        bool malformed = false;
+        while (nextField(p, value, malformed)) {
+            fields.push_back(value);
+        }
+
+        string problem;
+        if (malformed) {
+            problem = "non-numeric field";
+        } else if ((int)fields.size() != 4 + numResources) {
+            problem = "expected " + to_string(4 + numResources) + " fields, found " +
+                      to_string(fields.size());
+        } else {
+            problem = recordProblem(fields.data(), totalResources, firstLines, lineNumber, "line");
+        }
+        if (!problem.empty()) {
+            error = path + ":" + to_string(lineNumber) + ": " + problem;
+            ok = false;
+            break;
+        }
+
+        Process* process = new Process();
+        process->processID = (int)fields[0];
+        process->arrivalTime = (int)fields[1];
+        process->burstTime = (int)fields[2];
+        process->priority = (int)fields[3];
+        process->resourceRequirements.assign(fields.begin() + 4, fields.end());
+        process->remainingTime = process->burstTime;
+        loaded.push_back(process);
+    }
+    fclose(file);
+
+    if (!ok) {
+        for (Process* process : loaded) delete process;
+        return false;
+    }
+    processes.insert(processes.end(), loaded.begin(), loaded.end());
+    return true;
+}
+
+MappedTrace::MappedTrace() : mapping(nullptr), mappedBytes(0), header(nullptr), records(nullptr) {}
+
+MappedTrace::~MappedTrace() {
+    close();
+}
+
+bool MappedTrace::open(const string& path, string& error) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error = "Cannot open trace file " + path;
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(TraceHeader)) {
+        ::close(fd);
+        error = path + ": too small to be a binary trace";
+        return false;
+    }
+
+    size_t bytes = info.st_size;
+    void* base = mmap(NULL, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        error = "Cannot map trace file " + path;
+        return false;
+    }
+
+    const TraceHeader* mapped = (const TraceHeader*)base;
+    uint64_t expectedRecord = 4ULL * (RESOURCES + (uint64_t)mapped->numResources);
+    if (memcmp(mapped->magic, TRACE_MAGIC, sizeof(TRACE_MAGIC)) != 0) {
+        error = path + ": not a binary trace";
+    } else if (mapped->version != TRACE_VERSION) {
+        error = path + ": unsupported trace version " + to_string(mapped->version);
+    } else if (mapped->byteOrder != TRACE_BYTE_ORDER) {
+        error = path + ": trace was written with a different byte order";
+    } else if (mapped->recordSize != expectedRecord) {
+        error = path + ": record size does not match resource count";
+    } else if ((bytes - sizeof(TraceHeader)) / expectedRecord < mapped->processCount) {
+        error = path + ": truncated, header promises " + to_string(mapped->processCount) + " records";
+    } else {
+        madvise(base, bytes, MADV_SEQUENTIAL);
+        mapping = base;
+        mappedBytes = bytes;
+        header = mapped;
+        records = (const int32_t*)(mapped + 1);
+        return true;
+    }
+    munmap(base, bytes);
+    return false;
+}
+
+void MappedTrace::close() {
+    if (mapping) {
+        munmap(mapping, mappedBytes);
+    }
+    mapping = nullptr;
+    mappedBytes = 0;
+    header = nullptr;
+    records = nullptr;
+}
+
+Process* MappedTrace::makeProcess(size_t i) const {
+    const int32_t* fields = record(i);
+    Process* process = new Process();
+    process->processID = fields[PID];
+    process->arrivalTime = fields[ARRIVAL];
+    process->burstTime = fields[BURST];
+    process->priority = fields[PRIORITY];
+    process->resourceRequirements.assign(fields + RESOURCES, fields + RESOURCES + header->numResources);
+    process->remainingTime = process->burstTime;
+    return process;
+}
+
+bool isBinaryTrace(const string& path) {
+    char magic[sizeof(TRACE_MAGIC)];
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+    bool binary = fread(magic, 1, sizeof(magic), file) == sizeof(magic) &&
+                  memcmp(magic, TRACE_MAGIC, sizeof(magic)) == 0;
+    fclose(file);
+    return binary;
+}
+
+bool loadTrace(const string& path, const vector<int>& totalResources,
+               vector<Process*>& processes, string& error) {
+    if (!isBinaryTrace(path)) {
+        return loadTextTrace(path, totalResources, processes, error);
+    }
+    int numResources = totalResources.size();
+
+    MappedTrace trace;
+    if (!trace.open(path, error)) {
+        return false;
+    }
+    if (trace.numResources() != numResources) {
+        error = path + ": trace has " + to_string(trace.numResources()) +
+                " resource types, expected " + to_string(numResources);
+        return false;
+    }
+
+    // Same checks as a text trace: a negative burst would never finish
+    size_t count = trace.size();
+    unordered_map<long, int> firstRecords;
+    for (size_t i = 0; i < count; i++) {
+        string problem = recordProblem(trace.record(i), totalResources, firstRecords, i + 1, "record");
+        if (!problem.empty()) {
+            error = path + ":record " + to_string(i + 1) + ": " + problem;
+            return false;
+        }
+    }
+
+    processes.reserve(processes.size() + count);
+    for (size_t i = 0; i < count; i++) {
+        processes.push_back(trace.makeProcess(i));
+    }
+    return true;
+}
+
+bool writeBinaryTrace(const string& path, int numResources,
+                      const vector<Process*>& processes, string& error) {
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file) {
+        error = "Cannot write trace file " + path;
+        return false;
+    }
+
+    TraceHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC));
+    header.version = TRACE_VERSION;
+    header.byteOrder = TRACE_BYTE_ORDER;
+    header.numResources = numResources;
+    header.recordSize = 4 * (MappedTrace::RESOURCES + numResources);
+    header.processCount = processes.size();
+    fwrite(&header, sizeof(header), 1, file);
+
+    vector<int32_t> record(MappedTrace::RESOURCES + numResources);
+    for (const Process* p : processes) {
+        record[MappedTrace::PID] = p->processID;
+        record[MappedTrace::ARRIVAL] = p->arrivalTime;
+        record[MappedTrace::BURST] = p->burstTime;
+        record[MappedTrace::PRIORITY] = p->priority;
+        for (int i = 0; i < numResources; i++) {
+            record[MappedTrace::RESOURCES + i] =
+                i < (int)p->resourceRequirements.size() ? p->resourceRequirements[i] : 0;
+        }
+        fwrite(record.data(), sizeof(int32_t), record.size(), file);
+    }
+
+    bool written = !ferror(file);
+    if (fclose(file) != 0) written = false;
+    if (!written) {
+        error = "Error while writing trace file " + path;
+    }
+    return written;
+}
@@ -0,0 +1,82 @@
+#ifndef WORKLOAD_TRACE_H
+#define WORKLOAD_TRACE_H
+
+#include <cstddef>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "Process.h"
+
+// Load a text workload trace: one process per line as
+//   PID ARRIVAL BURST PRIORITY R1 R2 ... Rm
+// with one requirement column per entry of totalResources, separated by
+// whitespace or commas (so CSV works too; a leading header row is skipped).
+// Blank lines and lines starting with '#' are skipped. PIDs must be unique
+// and no requirement may exceed its resource's total, or the process could
+// never be granted. On success the caller owns the processes; on failure
+// nothing is returned and error names the offending line.
+bool loadTextTrace(const std::string& path, const std::vector<int>& totalResources,
+                   std::vector<Process*>& processes, std::string& error);
+
+// Binary trace layout, in native byte order:
+//   TraceHeader, then processCount fixed-width records of recordSize bytes.
+//   Each record is int32 PID, ARRIVAL, BURST, PRIORITY followed by
+//   numResources int32 resource requirements.
+struct TraceHeader {
+    char magic[8];          // "CCPTRACE"
+    uint32_t version;
+    uint32_t byteOrder;     // TRACE_BYTE_ORDER as written by the producer
+    uint32_t numResources;
+    uint32_t recordSize;    // Bytes per record: 4 * (4 + numResources)
+    uint64_t processCount;
+};
+
+static const uint32_t TRACE_VERSION = 1;
+static const uint32_t TRACE_BYTE_ORDER = 0x01020304;
+
+// Read-only view of a binary trace mapped with mmap. Records are read in
+// place; nothing is parsed or copied until a Process is built from one.
+class MappedTrace {
+private:
+    void* mapping;
+    size_t mappedBytes;
+    const TraceHeader* header;
+    const int32_t* records;
+
+    MappedTrace(const MappedTrace&);
+    MappedTrace& operator=(const MappedTrace&);
+
+public:
+    enum Field { PID = 0, ARRIVAL, BURST, PRIORITY, RESOURCES };
+
+    MappedTrace();
+    ~MappedTrace();
+
+    bool open(const std::string& path, std::string& error);
+    void close();
+
+    size_t size() const { return header ? header->processCount : 0; }
+    int numResources() const { return header ? header->numResources : 0; }
+
+    // Fields of record i, indexed by Field; resources start at RESOURCES
+    const int32_t* record(size_t i) const {
+        return records + i * (RESOURCES + header->numResources);
+    }
+
+    // Build a Process from record i; the caller owns it
+    Process* makeProcess(size_t i) const;
+};
+
+// True if the file starts with the binary trace magic
+bool isBinaryTrace(const std::string& path);
+
+// Load either format, picking binary or text by the file's magic. Binary
+// records are checked like text lines; error names the record.
+bool loadTrace(const std::string& path, const std::vector<int>& totalResources,
+               std::vector<Process*>& processes, std::string& error);
+
+// Write processes as a binary trace with numResources requirement columns
+bool writeBinaryTrace(const std::string& path, int numResources,
+                      const std::vector<Process*>& processes, std::string& error);
+
+#endif
@@ -0,0 +1,183 @@
+#include "MicroBench.h"
+#include <pthread.h>
+#include <ostream>
+#include <vector>
+#include "BankersAlgorithm.h"
+#include "BoundedBuffer.h"
+#include "LockFreeBuffer.h"
+#include "Scheduler.h"
+#include "Logger.h"
+#include "Random.h"
+
+using namespace std;
+
+static const int NUM_RESOURCES = 3;
+
+// n processes demanding 1-5 of each resource, with enough of everything that
+// every request can be granted
+static vector<Process*> makeBankerWorkload(int n) {
+    Random random(42);
+    vector<Process*> processes;
+    for (int i = 0; i < n; i++) {
+        Process* p = new Process();
+        p->processID = i + 1;
+        for (int r = 0; r < NUM_RESOURCES; r++) {
+            p->resourceRequirements.push_back(random.uniform(1, 5));
+        }
+        processes.push_back(p);
+    }
+    return processes;
+}
+
+// Grant and release on the cached safe sequence: the path the schedulers take
+static void BM_BankerRequestRelease(BenchState& state) {
+    int n = state.range();
+    vector<Process*> processes = makeBankerWorkload(n);
+    BankersAlgorithm banker(NUM_RESOURCES, vector<int>(NUM_RESOURCES, 5 * n));
+    banker.addProcesses(processes.data(), n);
+
+    int next = 0;
+    while (state.keepRunning()) {
+        banker.requestResources(processes[next]);
+        banker.releaseResources(processes[next]);
+        if (++next == n) next = 0;
+    }
+    state.setItemsProcessed(state.iterations());
+    for (Process* p : processes) delete p;
+}
+BENCHMARK(BM_BankerRequestRelease)->range(10, 100000, 10);
+
+// A request from a process the Banker does not track always runs the full
+// safety algorithm (isSafe) over every registered process. Half of them hold
+// their maximum so the check has real allocations to hand back.
+static void BM_BankerIsSafe(BenchState& state) {
+    int n = state.range();
+    vector<Process*> processes = makeBankerWorkload(n);
+    BankersAlgorithm banker(NUM_RESOURCES, vector<int>(NUM_RESOURCES, 5 * n));
+    banker.addProcesses(processes.data(), n);
+    for (int i = 0; i < n; i += 2) {
+        banker.requestResources(processes[i]);
+    }
+
+    Process probe;
+    probe.resourceRequirements.assign(NUM_RESOURCES, 0);
+    probe.allocatedResources.assign(NUM_RESOURCES, 0);
+    while (state.keepRunning()) {
+        banker.requestResources(&probe);
+        banker.releaseResources(&probe);
+    }
+    state.setItemsProcessed(state.iterations());
+    for (Process* p : processes) delete p;
+}
+BENCHMARK(BM_BankerIsSafe)->range(10, 10000, 10);
+
+// Buffer throughput: `threads` producers and as many consumers move
+// BUFFER_ITEMS pointers through a 64-slot buffer per iteration. Thread start
+// and join are included, which is small next to the transfers.
+static const int BUFFER_ITEMS = 1 << 16;
+
+struct BufferWorker {
+    ProcessBuffer* buffer;
+    Process* process;
+    int count;
+};
+
+static void* bufferProducer(void* arg) {
+    BufferWorker* worker = (BufferWorker*)arg;
+    for (int i = 0; i < worker->count; i++) {
+        worker->buffer->insert(worker->process);
+    }
+    return NULL;
+}
+
+static void* bufferConsumer(void* arg) {
+    BufferWorker* worker = (BufferWorker*)arg;
+    for (int i = 0; i < worker->count; i++) {
+        worker->buffer->remove();
+    }
+    return NULL;
+}
+
+static void transferThroughBuffer(ProcessBuffer& buffer, int threads) {
+    Process process;
+    vector<BufferWorker> workers(threads);
+    vector<pthread_t> producers(threads), consumers(threads);
+    for (int i = 0; i < threads; i++) {
+        workers[i].buffer = &buffer;
+        workers[i].process = &process;
+        workers[i].count = BUFFER_ITEMS / threads + (i < BUFFER_ITEMS % threads ? 1 : 0);
+    }
+    for (int i = 0; i < threads; i++) {
+        pthread_create(&producers[i], NULL, bufferProducer, &workers[i]);
+        pthread_create(&consumers[i], NULL, bufferConsumer, &workers[i]);
+    }
+    for (int i = 0; i < threads; i++) {
+        pthread_join(producers[i], NULL);
+        pthread_join(consumers[i], NULL);
+    }
+}
+
+static void BM_BoundedBuffer(BenchState& state) {
+    BoundedBuffer buffer(64);
+    while (state.keepRunning()) {
+        transferThroughBuffer(buffer, state.range());
+    }
+    state.setItemsProcessed(state.iterations() * BUFFER_ITEMS);
+}
+BENCHMARK(BM_BoundedBuffer)->range(1, 32, 2);
+
+static void BM_LockFreeBuffer(BenchState& state) {
+    LockFreeBuffer buffer(64);
+    while (state.keepRunning()) {
+        transferThroughBuffer(buffer, state.range());
+    }
+    state.setItemsProcessed(state.iterations() * BUFFER_ITEMS);
+}
+BENCHMARK(BM_LockFreeBuffer)->range(1, 32, 2);
+
+// A single-CPU workload at about 90% load: bursts 1-10, priorities 1-5 and
+// gaps of 0-12 between arrivals. No Banker, so only the scheduler is timed.
+static void runScheduling(BenchState& state, SchedulingPolicy policy) {
+    int n = state.range();
+    Random random(7);
+    Scheduler scheduler;
+    ostream silent(nullptr);
+    scheduler.setOutput(&silent);
+    scheduler.setPolicy(policy);
+
+    vector<Process*> processes;
+    int clock = 0;
+    for (int i = 0; i < n; i++) {
+        Process* p = new Process();
+        p->processID = i + 1;
+        p->arrivalTime = clock;
+        p->burstTime = random.uniform(1, 10);
+        p->priority = random.uniform(1, 5);
+        p->resourceRequirements.assign(NUM_RESOURCES, 1);
+        processes.push_back(p);
+        clock += random.uniform(0, 12);
+    }
+    scheduler.addProcesses(processes);
+
+    while (state.keepRunning()) {
+        scheduler.executeScheduling();
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+static void BM_PriorityScheduling(BenchState& state) {
+    runScheduling(state, POLICY_PRIORITY);
+}
+BENCHMARK(BM_PriorityScheduling)->range(1000, 1000000, 10);
+
+static void BM_RoundRobinScheduling(BenchState& state) {
+    runScheduling(state, POLICY_ROUND_ROBIN);
+}
+BENCHMARK(BM_RoundRobinScheduling)->range(1000, 1000000, 10);
+
+int main(int argc, char* argv[]) {
+    Logger::setLevel(LOG_LEVEL_ERROR);
+    int status = runBenchmarks(argc, argv);
+    Logger::shutdown();
+    return status;
+}
@@ -0,0 +1,98 @@
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include "BoundedBuffer.h"
+#include "LockFreeBuffer.h"
+#include "Logger.h"
+
+// Checks that handing a process through either buffer allocates nothing:
+// every operator new is counted, and the count must not move across the
+// insert/remove pairs. Exits non-zero if it does.
+
+static std::atomic<long> allocations(0);
+
+void* operator new(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    void* block = malloc(size ? size : 1);
+    if (!block) {
+        throw std::bad_alloc();
+    }
+    return block;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* block) noexcept {
+    free(block);
+}
+
+void operator delete[](void* block) noexcept {
+    free(block);
+}
+
+void operator delete(void* block, size_t) noexcept {
+    free(block);
+}
+
+void operator delete[](void* block, size_t) noexcept {
+    free(block);
+}
+
+static const int CAPACITY = 8;
+static const int PAIRS = 4000;
+
+// Allocations made by PAIRS single and PAIRS / 4 batched insert/remove
+// rounds, after one warm-up round of each
+static long countHandoffAllocations(ProcessBuffer& buffer) {
+    Process process;
+    Process* batch[4] = { &process, &process, &process, &process };
+    Process* received[4];
+
+    buffer.insert(&process);
+    buffer.remove();
+    buffer.insertBatch(batch, 4);
+    buffer.removeBatch(received, 4);
+
+    long before = allocations.load();
+    for (int i = 0; i < PAIRS; i++) {
+        buffer.insert(&process);
+        if (buffer.remove() != &process) {
+            fprintf(stderr, "remove returned a different process\n");
+            exit(1);
+        }
+    }
+    for (int i = 0; i < PAIRS / 4; i++) {
+        int inserted = buffer.insertBatch(batch, 4);
+        int removed = 0;
+        while (removed < inserted) {
+            removed += buffer.removeBatch(received, inserted - removed);
+        }
+    }
+    return allocations.load() - before;
+}
+
+int main() {
+    Logger::setLevel(LOG_LEVEL_ERROR);
+
+    BoundedBuffer bounded(CAPACITY);
+    LockFreeBuffer lockFree(CAPACITY);
+    struct { const char* name; ProcessBuffer* buffer; } buffers[] = {
+        { "BoundedBuffer", &bounded },
+        { "LockFreeBuffer", &lockFree }
+    };
+
+    int failures = 0;
+    for (const auto& entry : buffers) {
+        long count = countHandoffAllocations(*entry.buffer);
+        printf("%-16s %ld allocations in %d hand-offs: %s\n", entry.name, count,
+               PAIRS + PAIRS / 4 * 4, count == 0 ? "ok" : "FAILED");
+        if (count != 0) {
+            failures++;
+        }
+    }
+    Logger::shutdown();
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,274 @@
+#ifndef MICRO_BENCH_H
+#define MICRO_BENCH_H
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <regex>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+// Minimal benchmark harness with the interface and output of Google
+// Benchmark, so results can be fed to its tools (compare.py) without the
+// dependency. A benchmark is a function taking BenchState; each run repeats
+// the timed loop, growing the iteration count until it takes min_time.
+//
+//   static void BM_Example(BenchState& state) {
+//       while (state.keepRunning()) { ... }
+//       state.setItemsProcessed(state.iterations() * itemsPerIteration);
+//   }
+//   BENCHMARK(BM_Example)->range(1000, 1000000, 10);
+//
+// Flags: --benchmark_filter=REGEX, --benchmark_min_time=SECONDS,
+// --benchmark_format=console|json, --benchmark_out=FILE (always JSON).
+class BenchState {
+private:
+    long maxIterations;
+    long done;
+    long argument;
+    long items;
+    bool timing;
+    std::chrono::steady_clock::time_point wallStart;
+    double wallSeconds;
+    double cpuStart;
+    double cpuSeconds;
+
+    static double cpuNow() {
+        timespec now;
+        clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now);
+        return now.tv_sec + now.tv_nsec * 1e-9;
+    }
+
+public:
+    BenchState(long iterations, long arg)
+        : maxIterations(iterations), done(0), argument(arg), items(0), timing(false),
+          wallSeconds(0), cpuStart(0), cpuSeconds(0) {}
+
+    // True while more iterations are due; times everything in between
+    bool keepRunning() {
+        if (done == 0 && !timing) {
+            resumeTiming();
+        }
+        if (done < maxIterations) {
+            done++;
+            return true;
+        }
+        if (timing) {
+            pauseTiming();
+        }
+        return false;
+    }
+
+    // Leave setup work inside the loop out of the measurement
+    void pauseTiming() {
+        wallSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+        cpuSeconds += cpuNow() - cpuStart;
+        timing = false;
+    }
+
+    void resumeTiming() {
+        wallStart = std::chrono::steady_clock::now();
+        cpuStart = cpuNow();
+        timing = true;
+    }
+
+    long range() const { return argument; }
+    long iterations() const { return maxIterations; }
+    void setItemsProcessed(long count) { items = count; }
+
+    long itemsProcessed() const { return items; }
+    double wallTime() const { return wallSeconds; }
+    double cpuTime() const { return cpuSeconds; }
+};
+
+class Benchmark {
+public:
+    typedef void (*Function)(BenchState&);
+
+    Benchmark(const char* benchName, Function benchFunction) : name(benchName), function(benchFunction) {}
+
+    Benchmark* arg(long value) {
+        arguments.push_back(value);
+        return this;
+    }
+
+    // low, low*multiplier, ... up to and including high
+    Benchmark* range(long low, long high, long multiplier) {
+        for (long value = low; value < high; value *= multiplier) {
+            arguments.push_back(value);
+        }
+        arguments.push_back(high);
+        return this;
+    }
+
+    static std::vector<Benchmark*>& registry() {
+        static std::vector<Benchmark*> benchmarks;
+        return benchmarks;
+    }
+
+    static Benchmark* add(const char* benchName, Function benchFunction) {
+        registry().push_back(new Benchmark(benchName, benchFunction));
+        return registry().back();
+    }
+
+    std::string name;
+    Function function;
+    std::vector<long> arguments;
+};
+
+#define BENCH_CONCAT_(a, b) a##b
+#define BENCH_CONCAT(a, b) BENCH_CONCAT_(a, b)
+#define BENCHMARK(function) \
+    static Benchmark* BENCH_CONCAT(benchmark_, __LINE__) = Benchmark::add(#function, function)
+
+struct BenchResult {
+    std::string name;
+    long iterations;
+    double realNs;  // Per iteration
+    double cpuNs;
+    double itemsPerSecond;
+};
+
+static inline bool benchFlag(const char* arg, const char* flag, std::string& value) {
+    size_t length = strlen(flag);
+    if (strncmp(arg, flag, length) != 0 || arg[length] != '=') {
+        return false;
+    }
+    value = arg + length + 1;
+    return true;
+}
+
+static inline void writeBenchJSON(FILE* file, const char* executable, const std::vector<BenchResult>& results) {
+    char date[64];
+    time_t now = time(NULL);
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", localtime(&now));
+    char host[256] = "";
+    gethostname(host, sizeof(host) - 1);
+
+    fprintf(file, "{\n  \"context\": {\n");
+    fprintf(file, "    \"date\": \"%s\",\n", date);
+    fprintf(file, "    \"host_name\": \"%s\",\n", host);
+    fprintf(file, "    \"executable\": \"%s\",\n", executable);
+    fprintf(file, "    \"num_cpus\": %ld,\n", sysconf(_SC_NPROCESSORS_ONLN));
+    fprintf(file, "    \"library_build_type\": \"release\"\n  },\n");
+    fprintf(file, "  \"benchmarks\": [\n");
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& result = results[i];
+        fprintf(file, "    {\n      \"name\": \"%s\",\n      \"run_name\": \"%s\",\n",
+                result.name.c_str(), result.name.c_str());
+        fprintf(file, "      \"run_type\": \"iteration\",\n");
+        fprintf(file, "      \"iterations\": %ld,\n", result.iterations);
+        fprintf(file, "      \"real_time\": %.6e,\n      \"cpu_time\": %.6e,\n", result.realNs, result.cpuNs);
+        fprintf(file, "      \"time_unit\": \"ns\"");
+        if (result.itemsPerSecond > 0) {
+            fprintf(file, ",\n      \"items_per_second\": %.6e", result.itemsPerSecond);
+        }
+        fprintf(file, "\n    }%s\n", i + 1 < results.size() ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+}
+
+// Run every registered benchmark that matches the filter. Returns the exit
+// status for main.
+static inline int runBenchmarks(int argc, char* argv[]) {
+    std::string filter = ".";
+    std::string format = "console";
+    std::string outPath;
+    double minTime = 0.5;
+    for (int i = 1; i < argc; i++) {
+        std::string value;
+        if (benchFlag(argv[i], "--benchmark_filter", value)) {
+            filter = value;
+        } else if (benchFlag(argv[i], "--benchmark_min_time", value)) {
+            minTime = atof(value.c_str());
+        } else if (benchFlag(argv[i], "--benchmark_format", value) && (value == "console" || value == "json")) {
+            format = value;
+        } else if (benchFlag(argv[i], "--benchmark_out", value)) {
+            outPath = value;
+        } else {
+            fprintf(stderr, "Unknown argument %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    std::regex pattern;
+    try {
+        pattern = std::regex(filter);
+    } catch (const std::regex_error&) {
+        fprintf(stderr, "Invalid --benchmark_filter '%s'\n", filter.c_str());
+        return 1;
+    }
+
+    bool console = format == "console";
+    if (console) {
+        printf("%-44s %14s %14s %12s %16s\n", "Benchmark", "Time (ns)", "CPU (ns)", "Iterations", "Items/s");
+        printf("%s\n", std::string(104, '-').c_str());
+    }
+
+    std::vector<BenchResult> results;
+    for (Benchmark* benchmark : Benchmark::registry()) {
+        std::vector<long> arguments = benchmark->arguments;
+        bool hasArgument = !arguments.empty();
+        if (!hasArgument) {
+            arguments.push_back(0);
+        }
+        for (long argument : arguments) {
+            std::string name = benchmark->name;
+            if (hasArgument) {
+                name += "/" + std::to_string(argument);
+            }
+            if (!std::regex_search(name, pattern)) {
+                continue;
+            }
+
+            // Grow the iteration count until one run lasts min_time
+            long iterations = 1;
+            while (true) {
+                BenchState state(iterations, argument);
+                benchmark->function(state);
+                double elapsed = state.wallTime();
+                if (elapsed >= minTime || iterations >= 1000000000L) {
+                    BenchResult result;
+                    result.name = name;
+                    result.iterations = iterations;
+                    result.realNs = elapsed * 1e9 / iterations;
+                    result.cpuNs = state.cpuTime() * 1e9 / iterations;
+                    result.itemsPerSecond = elapsed > 0 ? state.itemsProcessed() / elapsed : 0;
+                    results.push_back(result);
+                    if (console) {
+                        printf("%-44s %14.1f %14.1f %12ld", name.c_str(), result.realNs, result.cpuNs, iterations);
+                        if (result.itemsPerSecond > 0) {
+                            printf(" %16.4g", result.itemsPerSecond);
+                        }
+                        printf("\n");
+                        fflush(stdout);
+                    }
+                    break;
+                }
+                double multiplier = elapsed > 0 ? 1.4 * minTime / elapsed : 10;
+                if (multiplier > 10) multiplier = 10;
+                if (multiplier < 2) multiplier = 2;
+                iterations = (long)(iterations * multiplier);
+            }
+        }
+    }
+
+    if (!console) {
+        writeBenchJSON(stdout, argv[0], results);
+    }
+    if (!outPath.empty()) {
+        FILE* file = fopen(outPath.c_str(), "w");
+        if (!file) {
+            fprintf(stderr, "Cannot write %s\n", outPath.c_str());
+            return 1;
+        }
+        writeBenchJSON(file, argv[0], results);
+        fclose(file);
+    }
+    return 0;
+}
+
+#endif
@@ -0,0 +1,76 @@
+#include "ResourceKernel.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+
+using namespace std;
+
+// Times one safety-check style pass: compare every need row against work and
+// add the matching allocation row. work is reset before each pass, so needs
+// always fit and every element is read and added.
+static double nsPerRow(const ResourceKernel& kernel, int m, int rows,
+                       const vector<int>& need, const vector<int>& allocation) {
+    vector<int> work(m, 1 << 20);
+    long long checksum = 0;
+    long long iterations = 0;
+    auto start = chrono::steady_clock::now();
+    double elapsed = 0;
+    
+    while (elapsed < 0.2) {
+        fill(work.begin(), work.end(), 1 << 20);
+        for (int r = 0; r < rows; r++) {
+            if (kernel.fits(&need[r * m], work.data(), m)) {
+                kernel.add(work.data(), &allocation[r * m], m);
+            }
+        }
+        checksum += work[m - 1];
+        iterations++;
+        elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    }
+    
+    // Keep the passes from being optimized away
+    asm volatile("" : : "r"(checksum) : "memory");
+    return elapsed * 1e9 / (double)(iterations * rows);
+}
+
+int main() {
+    const int sizes[] = { 3, 16, 64, 256 };
+    const char* kernels[] = { "scalar", "sse2", "avx2" };
+    
+    cout << "========================================" << endl;
+    cout << "  RESOURCE KERNEL BENCHMARK" << endl;
+    cout << "========================================" << endl;
+    cout << "Active kernel: " << activeResourceKernel().name << "\n" << endl;
+    cout << left << setw(8) << "m" << setw(10) << "Kernel"
+         << setw(14) << "ns/row" << "Speedup" << endl;
+    cout << "----------------------------------------" << endl;
+    
+    for (int m : sizes) {
+        // Keep each matrix around 256 KB regardless of m
+        int rows = 65536 / m;
+        vector<int> need(rows * m), allocation(rows * m);
+        for (size_t i = 0; i < need.size(); i++) {
+            need[i] = i % 4;
+            allocation[i] = 1 + i % 3;
+        }
+        
+        double scalarTime = 0;
+        for (const char* name : kernels) {
+            const ResourceKernel* kernel = findResourceKernel(name);
+            if (!kernel) {
+                continue;
+            }
+            double t = nsPerRow(*kernel, m, rows, need, allocation);
+            if (kernel == findResourceKernel("scalar")) {
+                scalarTime = t;
+            }
+            cout << left << setw(8) << m << setw(10) << kernel->name
+                 << setw(14) << fixed << setprecision(2) << t
+                 << setprecision(2) << (scalarTime / t) << "x" << endl;
+        }
+    }
+    cout << "========================================" << endl;
+    return 0;
+}
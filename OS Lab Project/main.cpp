@@ -1,11 +1,20 @@
 #include <iostream>
 #include <pthread.h>
-#include <cstdlib>
 #include <ctime>
+#include <chrono>
+#include <iomanip>
+#include <atomic>
 #include "BoundedBuffer.h"
+#include "LockFreeBuffer.h"
 #include "Scheduler.h"
 #include "ProducerConsumer.h"
 #include "BankersAlgorithm.h"
+#include "Logger.h"
+#include "SimulationConfig.h"
+#include "WorkloadTrace.h"
+#include "ResultExport.h"
+#include "ScenarioSweep.h"
+#include "Instrumentation.h"
 
 using namespace std;
 
@@ -27,52 +36,87 @@ void displayMenu() {
     cout << "Enter your choice: ";
 }
 
-void startSimulation() {
-    srand(time(NULL));
-    
-    cout << "\n========================================" << endl;
-    cout << "  PRODUCER-CONSUMER SIMULATION" << endl;
-    cout << "========================================\n" << endl;
-    
-    int numProducers, bufferSize, totalProcesses, timeQuantum;
-    
+// Ask for the simulation parameters on stdin
+void readSimulationConfig(SimulationConfig& config) {
     cout << "Enter number of producer threads (minimum 2): ";
-    cin >> numProducers;
-    if (numProducers < 2) {
+    cin >> config.numProducers;
+    if (config.numProducers < 2) {
         cout << "Warning: At least 2 producers required. Setting to 2." << endl;
-        numProducers = 2;
+        config.numProducers = 2;
     }
     
     cout << "Enter buffer size: ";
-    cin >> bufferSize;
+    cin >> config.bufferSize;
+    if (config.bufferSize < 1) {
+        cout << "Warning: Buffer size must be at least 1. Setting to 1." << endl;
+        config.bufferSize = 1;
+    }
+    
+    int bufferType;
+    cout << "Select buffer (1 = Semaphore/Mutex, 2 = Lock-free ring): ";
+    cin >> bufferType;
+    config.bufferType = (bufferType == 2) ? BUFFER_LOCK_FREE : BUFFER_MUTEX;
     
     cout << "Enter total number of processes to generate: ";
-    cin >> totalProcesses;
+    cin >> config.totalProcesses;
+    
+    cout << "Enter batch size (1 = no batching): ";
+    cin >> config.batchSize;
+    if (config.batchSize < 1) {
+        config.batchSize = 1;
+    }
     
     // Determine if we need time quantum (only for Round Robin when >5 processes)
-    timeQuantum = 2; // Default value
-    if (totalProcesses > 5) {
+    config.timeQuantum = 2; // Default value
+    if (config.totalProcesses > 5) {
         cout << "Enter time quantum for Round Robin: ";
-        cin >> timeQuantum;
+        cin >> config.timeQuantum;
     }
     
-    // Initialize Banker's Algorithm
-    if (globalBanker) delete globalBanker;
-    globalBanker = new BankersAlgorithm(numResourceTypes, totalResources);
-    
-    // Initialize Scheduler
-    if (globalScheduler) delete globalScheduler;
-    globalScheduler = new Scheduler();
-    globalScheduler->setTimeQuantum(timeQuantum);
-    globalScheduler->setBanker(globalBanker);
-    
-    BoundedBuffer buffer(bufferSize);
+    config.totalResources = totalResources;
+}
+
+// Print how many log records were lost since the last report; the Logger's
+// count covers the whole run
+void reportDroppedLogs() {
+    static unsigned long reported = 0;
+    Logger::flush();
+    unsigned long dropped = Logger::droppedCount();
+    if (dropped > reported) {
+        cout << "[LOGGER] " << dropped - reported
+             << " log messages dropped (ring full)" << endl;
+        reported = dropped;
+    }
+}
+
+// Run the producers and consumers to fill globalScheduler with random processes
+void produceProcesses(const SimulationConfig& config, uint64_t seed) {
+    ProcessBuffer* buffer;
+    if (config.bufferType == BUFFER_LOCK_FREE) {
+        LockFreeBuffer* ring = new LockFreeBuffer(config.bufferSize);
+        if (ring->capacity() != config.bufferSize) {
+            cout << "Note: Lock-free buffer capacity rounded up to " 
+                 << ring->capacity() << endl;
+        }
+        buffer = ring;
+    } else {
+        buffer = new BoundedBuffer(config.bufferSize);
+    }
+    buffer->setMaxBatchSize(config.batchSize);
+    
+    // Virtual time: producers and consumers (in that order) share one timeline
+    VirtualTimeline* timeline = nullptr;
+    if (config.virtualTime) {
+        int capacity = config.bufferType == BUFFER_LOCK_FREE
+            ? ((LockFreeBuffer*)buffer)->capacity() : config.bufferSize;
+        timeline = new VirtualTimeline(config.numProducers + config.numConsumers, capacity);
+    }
     
-    int nextProcessID = 1;
-    pthread_mutex_t idMutex;
-    pthread_mutex_init(&idMutex, NULL);
+    int numProducers = config.numProducers;
+    int numConsumers = config.numConsumers;
+    int totalProcesses = config.totalProcesses;
     
-    bool consumerFinished = false;
+    int consumersFinished = 0;
     pthread_mutex_t finishMutex;
     pthread_mutex_init(&finishMutex, NULL);
     
@@ -86,49 +130,200 @@ void startSimulation() {
     cout << "STARTING THREADS" << endl;
     cout << "========================================" << endl;
     
+    // Each producer owns a contiguous block of process IDs
+    int nextProcessID = 1;
     for (int i = 0; i < numProducers; i++) {
         producerArgs[i].producerID = i + 1;
         producerArgs[i].numProcesses = processesPerProducer;
         if (i == 0) producerArgs[i].numProcesses += remainingProcesses;
-        producerArgs[i].buffer = &buffer;
-        producerArgs[i].nextProcessID = &nextProcessID;
-        producerArgs[i].idMutex = &idMutex;
+        producerArgs[i].buffer = buffer;
+        producerArgs[i].firstProcessID = nextProcessID;
+        producerArgs[i].seed = seed;
+        producerArgs[i].workload = &config.workload;
+        producerArgs[i].numProducers = numProducers;
+        producerArgs[i].virtualTime = config.virtualTime;
+        producerArgs[i].timeline = timeline;
+        producerArgs[i].timelineID = i;
+        nextProcessID += producerArgs[i].numProcesses;
         producerArgs[i].numResources = numResourceTypes;
+        producerArgs[i].batchSize = config.batchSize;
         
         pthread_create(&producers[i], NULL, producerThread, &producerArgs[i]);
     }
     
-    pthread_t consumer;
-    ConsumerArgs consumerArgs;
-    consumerArgs.buffer = &buffer;
-    consumerArgs.scheduler = globalScheduler;
-    consumerArgs.totalProcesses = totalProcesses;
-    consumerArgs.finished = &consumerFinished;
-    consumerArgs.finishMutex = &finishMutex;
-    
-    pthread_create(&consumer, NULL, consumerThread, &consumerArgs);
+    // Each consumer fills its own shard; they are merged once all have joined
+    atomic<int> unclaimed(totalProcesses);
+    vector<vector<Process*> > shards(numConsumers);
+    pthread_t* consumers = new pthread_t[numConsumers];
+    ConsumerArgs* consumerArgs = new ConsumerArgs[numConsumers];
+    
+    for (int i = 0; i < numConsumers; i++) {
+        consumerArgs[i].consumerID = i + 1;
+        consumerArgs[i].buffer = buffer;
+        consumerArgs[i].shard = &shards[i];
+        consumerArgs[i].unclaimed = &unclaimed;
+        consumerArgs[i].totalProcesses = totalProcesses;
+        consumerArgs[i].consumersFinished = &consumersFinished;
+        consumerArgs[i].finishMutex = &finishMutex;
+        consumerArgs[i].batchSize = config.batchSize;
+        consumerArgs[i].seed = seed;
+        consumerArgs[i].stream = (i == 0) ? 0 : numProducers + i;  // Producers use 1..numProducers
+        consumerArgs[i].virtualTime = config.virtualTime;
+        consumerArgs[i].timeline = timeline;
+        consumerArgs[i].timelineID = numProducers + i;
+        
+        pthread_create(&consumers[i], NULL, consumerThread, &consumerArgs[i]);
+    }
     
     for (int i = 0; i < numProducers; i++) {
         pthread_join(producers[i], NULL);
     }
-    pthread_join(consumer, NULL);
+    for (int i = 0; i < numConsumers; i++) {
+        pthread_join(consumers[i], NULL);
+    }
+    
+    for (int i = 0; i < numConsumers; i++) {
+        globalScheduler->addProcesses(shards[i]);
+    }
     
-    pthread_mutex_destroy(&idMutex);
     pthread_mutex_destroy(&finishMutex);
     delete[] producers;
     delete[] producerArgs;
+    delete[] consumers;
+    delete[] consumerArgs;
+    delete buffer;
+    delete timeline;
+    
+    reportDroppedLogs();
     
     cout << "\n========================================" << endl;
     cout << "ALL THREADS COMPLETED" << endl;
     cout << "========================================" << endl;
+}
+
+// Build a fresh scheduler and Banker from config, fill them from the trace
+// file or the producer-consumer pipeline, schedule, and report. Returns false
+// if the trace could not be loaded, some processes never completed, or the
+// results could not be exported.
+bool runSimulation(const SimulationConfig& config) {
+    numResourceTypes = config.totalResources.size();
+    totalResources = config.totalResources;
+    Instrumentation::reset();
+    
+    // Initialize Banker's Algorithm
+    if (globalBanker) delete globalBanker;
+    globalBanker = new BankersAlgorithm(numResourceTypes, totalResources);
+    
+    // Initialize Scheduler. The Banker is attached once the workload is
+    // complete, so it sees the processes in the scheduler's order.
+    if (globalScheduler) delete globalScheduler;
+    globalScheduler = new Scheduler();
+    configureScheduler(*globalScheduler, config);
+    
+    if (!config.traceFile.empty()) {
+        vector<Process*> trace;
+        string error;
+        auto loadStart = chrono::steady_clock::now();
+        if (!loadTrace(config.traceFile, totalResources, trace, error)) {
+            cerr << "Error: " << error << endl;
+            return false;
+        }
+        globalScheduler->addProcesses(trace);
+        if (config.sweep.empty()) {
+            globalScheduler->setBanker(globalBanker);
+        }
+        double loadMs = chrono::duration<double, milli>(chrono::steady_clock::now() - loadStart).count();
+        cout << "Loaded " << trace.size() << " processes from " << config.traceFile
+             << " in " << fixed << setprecision(1) << loadMs << " ms" << endl;
+    } else {
+        uint64_t seed = config.hasSeed ? config.seed : (uint64_t)time(NULL);
+        cout << "Random seed: " << seed << endl;
+        cout << "Workload: " << config.workload.describe() << endl;
+        produceProcesses(config, seed);
+        globalScheduler->sortProcessesByID();
+        if (config.sweep.empty()) {
+            globalScheduler->setBanker(globalBanker);
+        }
+    }
+    
+    // The workload just built is the template every scenario copies
+    if (!config.sweep.empty()) {
+        string error;
+        if (!runScenarioSweep(config, globalScheduler->getProcesses(), error)) {
+            cerr << "Error: " << error << endl;
+            return false;
+        }
+        reportDroppedLogs();
+        return true;
+    }
     
     // Display results
-    globalScheduler->displayProcessTable();
-    globalBanker->displaySystemState();
+    if (!config.quiet) {
+        globalScheduler->displayProcessTable();
+        globalBanker->displaySystemState();
+    }
+    
+    // Streamed Gantt entries go straight to the file; the chart is not kept
+    GanttFileSink ganttFile;
+    if (!config.ganttFile.empty()) {
+        string error;
+        if (!ganttFile.open(config.ganttFile, error)) {
+            cerr << "Error: " << error << endl;
+            return false;
+        }
+        globalScheduler->setGanttSink(&ganttFile);
+    }
     globalScheduler->executeScheduling();
-    globalScheduler->displayGanttChart();
-    globalScheduler->displayStatistics();
-    globalBanker->displaySystemState();
+    reportDroppedLogs();
+    int processCount = globalScheduler->getProcessCount();
+    long unfinished = processCount - globalScheduler->getStatistics().completed();
+    if (!config.quiet) {
+        globalScheduler->displayGanttChart();
+    }
+    globalScheduler->displayStatistics(!config.quiet);
+    if (!config.quiet) {
+        globalBanker->displaySystemState();
+#ifdef CCP_INSTRUMENT
+        Instrumentation::report();
+#endif
+    }
+    
+    if (!config.ganttFile.empty()) {
+        globalScheduler->setGanttSink(nullptr);
+        string error;
+        if (!ganttFile.close(error)) {
+            cerr << "Error: " << error << endl;
+            return false;
+        }
+        cout << "Gantt chart written to " << config.ganttFile << endl;
+    }
+    if (!config.resultsFile.empty()) {
+        string error;
+        vector<string> files;
+        if (!exportResults(config.resultsFile, *globalScheduler, *globalBanker, files, error)) {
+            cerr << "Error: " << error << endl;
+            return false;
+        }
+        for (const string& file : files) {
+            cout << "Results written to " << file << endl;
+        }
+    }
+    if (unfinished > 0) {
+        cerr << "Error: " << unfinished << " of " << processCount
+             << " processes never completed (blocked by the Banker)" << endl;
+        return false;
+    }
+    return true;
+}
+
+void startSimulation() {
+    cout << "\n========================================" << endl;
+    cout << "  PRODUCER-CONSUMER SIMULATION" << endl;
+    cout << "========================================\n" << endl;
+    
+    SimulationConfig config;
+    readSimulationConfig(config);
+    runSimulation(config);
 }
 
 void addProcessManually() {
@@ -199,7 +394,58 @@ void displaySystemState() {
     }
 }
 
-int main() {
+// Rewrite config.traceFile (text or binary) as a binary trace
+bool convertTrace(const SimulationConfig& config) {
+    int numResources = config.totalResources.size();
+    vector<Process*> trace;
+    string error;
+    bool ok = loadTrace(config.traceFile, config.totalResources, trace, error) &&
+              writeBinaryTrace(config.convertFile, numResources, trace, error);
+    if (ok) {
+        cout << "Converted " << trace.size() << " processes from " << config.traceFile
+             << " to " << config.convertFile << endl;
+    } else {
+        cerr << "Error: " << error << endl;
+    }
+    for (Process* p : trace) {
+        delete p;
+    }
+    return ok;
+}
+
+// Non-interactive mode: everything comes from the command line
+int runHeadless(int argc, char* argv[]) {
+    SimulationConfig config;
+    bool showHelp;
+    string error;
+    if (!parseCommandLine(argc, argv, config, showHelp, error)) {
+        cerr << "Error: " << error << endl;
+        printUsage(argv[0]);
+        return 1;
+    }
+    if (showHelp) {
+        printUsage(argv[0]);
+        return 0;
+    }
+    
+    bool ok;
+    if (!config.convertFile.empty()) {
+        ok = convertTrace(config);
+    } else {
+        ok = runSimulation(config);
+    }
+    
+    if (globalScheduler) delete globalScheduler;
+    if (globalBanker) delete globalBanker;
+    Logger::shutdown();
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        return runHeadless(argc, argv);
+    }
+    
     cout << "========================================" << endl;
     cout << "  COMPREHENSIVE CPU SCHEDULING SYSTEM" << endl;
     cout << "  Parts A, B, C Integration" << endl;
@@ -242,6 +488,7 @@ int main() {
     // Cleanup
     if (globalScheduler) delete globalScheduler;
     if (globalBanker) delete globalBanker;
+    Logger::shutdown();
     
     cout << "\n========================================" << endl;
     cout << "  SYSTEM SHUTDOWN COMPLETE" << endl;